@@ -8,9 +8,20 @@ ForceAffector::ForceAffector(sf::Vector2f force)
 {
 }
 
-void ForceAffector::operator() (Particle& particle, sf::Time dt)
+void ForceAffector::operator() (ParticleArray& particles, sf::Time dt)
 {
-	particle.velocity += mForce * dt.asSeconds();
+	const auto count = particles.velocityX.size();
+	const auto x = mForce.x * dt.asSeconds();
+	const auto y = mForce.y * dt.asSeconds();
+
+	auto* velocityX = particles.velocityX.data();
+	auto* velocityY = particles.velocityY.data();
+
+	for (auto i = std::size_t(0u); i < count; ++i)
+		velocityX[i] += x;
+
+	for (auto i = std::size_t(0u); i < count; ++i)
+		velocityY[i] += y;
 }
 
 RotateAffector::RotateAffector(float rotation)
@@ -18,7 +29,13 @@ RotateAffector::RotateAffector(float rotation)
 {
 }
 
-void RotateAffector::operator() (Particle& particle, sf::Time dt)
+void RotateAffector::operator() (ParticleArray& particles, sf::Time dt)
 {
-	particle.rotationSpeed += dt.asSeconds() * mRotation;
-}
\ No newline at end of file
+	const auto count = particles.rotationSpeed.size();
+	const auto delta = dt.asSeconds() * mRotation;
+
+	auto* rotationSpeed = particles.rotationSpeed.data();
+
+	for (auto i = std::size_t(0u); i < count; ++i)
+		rotationSpeed[i] += delta;
+}
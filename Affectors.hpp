@@ -5,13 +5,15 @@
 #include <SFML/System/Time.hpp>
 
 
-struct Particle;
+struct ParticleArray;
+
+// affectors run once per update over the whole particle array
 
 struct ForceAffector
 {
 	explicit ForceAffector(sf::Vector2f force);
 
-	void operator()(Particle& particle, sf::Time dt);
+	void operator()(ParticleArray& particles, sf::Time dt);
 
 
 private:
@@ -22,9 +24,9 @@ struct RotateAffector
 {
 	explicit RotateAffector(float rotation);
 
-	void operator() (Particle& particle, sf::Time dt);
+	void operator() (ParticleArray& particles, sf::Time dt);
 
 
 private:
 	float mRotation;
-};
\ No newline at end of file
+};
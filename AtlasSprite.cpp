@@ -0,0 +1,26 @@
+#include "AtlasSprite.hpp"
+#include "TextureAtlas.hpp"
+
+
+AtlasSprite::AtlasSprite(const TextureHolder& textures, Textures::ID sheet, const sf::IntRect& rect)
+	: sf::Sprite()
+	, mOffset(textures.getRegion(sheet).left, textures.getRegion(sheet).top)
+{
+	// headless atlases have no texture, the rect alone gives the sprite its bounds
+	if (const auto* texture = textures.get(sheet))
+		setTexture(*texture);
+
+	sf::Sprite::setTextureRect(textures.map(sheet, rect));
+}
+
+void AtlasSprite::setTextureRect(const sf::IntRect& rect)
+{
+	sf::Sprite::setTextureRect({ rect.left + mOffset.x, rect.top + mOffset.y, rect.width, rect.height });
+}
+
+sf::IntRect AtlasSprite::getTextureRect() const
+{
+	const auto& rect = sf::Sprite::getTextureRect();
+
+	return{ rect.left - mOffset.x, rect.top - mOffset.y, rect.width, rect.height };
+}
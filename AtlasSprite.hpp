@@ -0,0 +1,23 @@
+#pragma once
+
+
+#include "ResourceIdentifiers.hpp"
+
+#include <SFML/Graphics/Sprite.hpp>
+
+
+// Sprite drawn from a TextureAtlas sheet, texture rects are set and read
+// in sheet coordinates and shifted to the sheet's place in the atlas.
+// Hides sf::Sprite's rect accessors, like SceneNode hides the transform setters.
+class AtlasSprite final : public sf::Sprite
+{
+public:
+	AtlasSprite(const TextureHolder& textures, Textures::ID sheet, const sf::IntRect& rect);
+
+	void setTextureRect(const sf::IntRect& rect);
+	sf::IntRect getTextureRect() const;
+
+
+private:
+	sf::Vector2i mOffset;
+};
@@ -0,0 +1,127 @@
+#include "Benchmark.hpp"
+#include "DebugText.hpp"
+
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+
+
+namespace
+{
+	const static sf::Vector2f ViewSize(1024.f - 224.f, 512.f);
+
+	const static std::array<const char*, World::PhaseCount> PhaseNames =
+	{
+		"checkForCollision",
+		"command dispatch",
+		"removeWrecks",
+		"handleCollision",
+		"SceneGraph::update",
+		"LevelStreamer::update",
+	};
+
+	// nearest rank percentile, samples must be sorted
+	float percentile(const std::vector<float>& samples, float rank)
+	{
+		if (samples.empty()) return 0.f;
+
+		auto index = static_cast<std::size_t>(rank * (samples.size() - 1) + 0.5f);
+		return samples[index];
+	}
+}
+
+
+Benchmark::Benchmark(unsigned int goombas, unsigned int troopas, std::size_t ticks)
+	: mGoombas(goombas)
+	, mTroopas(troopas)
+	, mTicks(ticks)
+{
+}
+
+void Benchmark::run(const std::vector<std::string>& maps)
+{
+	std::cout << "goombas: " << mGoombas << ", troopas: " << mTroopas << ", ticks: " << mTicks << "\n";
+
+	for (const auto& map : maps)
+	{
+		try
+		{
+			runMap(map);
+		}
+		catch (std::exception& e)
+		{
+			std::cout << "\n" << map << ": skipped (" << e.what() << ")\n";
+		}
+	}
+}
+
+void Benchmark::runMap(const std::string& map)
+{
+	const auto TimePerFrame = sf::seconds(1 / 60.f);
+
+	World world(ViewSize, map);
+	spawnEnemies(world);
+
+	Samples samples;
+	for (auto& phase : samples)
+		phase.reserve(mTicks);
+
+	auto entityTicks = std::size_t(0u);
+
+	sf::Clock clock;
+	for (auto tick = 0u; tick < mTicks; ++tick)
+	{
+		world.update(TimePerFrame);
+		debug.clear();
+
+		const auto& times = world.getPhaseTimes();
+		for (auto i = 0u; i < World::PhaseCount; ++i)
+			samples[i].emplace_back(static_cast<float>(times[i].asMicroseconds()));
+
+		entityTicks += world.getBodyCount();
+	}
+
+	report(map, samples, clock.getElapsedTime().asSeconds(), entityTicks);
+}
+
+void Benchmark::spawnEnemies(World& world) const
+{
+	const auto bounds = world.getWorldBounds();
+	const auto count = mGoombas + mTroopas;
+
+	// spread evenly over the level, dropped in from the upper quarter
+	for (auto i = 0u; i < count; ++i)
+	{
+		sf::Vector2f position(bounds.left + bounds.width * (i + 0.5f) / count, bounds.top + bounds.height / 4.f);
+
+		if (i < mGoombas)
+			world.addGoomba(position);
+		else
+			world.addTroopa(position);
+	}
+}
+
+void Benchmark::report(const std::string& map, Samples& samples, float seconds, std::size_t entityTicks) const
+{
+	std::cout << "\n" << map << "\n"
+			  << std::left << std::setw(22) << "  phase"
+			  << std::right << std::setw(12) << "p50 (us)" << std::setw(12) << "p99 (us)" << std::setw(12) << "max (us)" << "\n";
+
+	for (auto i = 0u; i < World::PhaseCount; ++i)
+	{
+		auto& phase = samples[i];
+		std::sort(phase.begin(), phase.end());
+
+		std::cout << "  " << std::left << std::setw(20) << PhaseNames[i]
+				  << std::right << std::fixed << std::setprecision(1)
+				  << std::setw(12) << percentile(phase, 0.5f)
+				  << std::setw(12) << percentile(phase, 0.99f)
+				  << std::setw(12) << (phase.empty() ? 0.f : phase.back()) << "\n";
+	}
+
+	std::cout << "  entities per second: " << std::setprecision(0) << (seconds > 0.f ? entityTicks / seconds : 0.f) << "\n";
+	std::cout.unsetf(std::ios::floatfield);
+}
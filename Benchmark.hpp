@@ -0,0 +1,34 @@
+#pragma once
+
+#include "World.hpp"
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <string>
+#include <vector>
+
+
+// Loads every shipped map headless, spawns enemies and times each
+// World::update phase, printing p50, p99 and max latency per phase.
+class Benchmark final : private sf::NonCopyable
+{
+	using Samples = std::array<std::vector<float>, World::PhaseCount>;
+
+
+public:
+	Benchmark(unsigned int goombas, unsigned int troopas, std::size_t ticks);
+
+	void run(const std::vector<std::string>& maps);
+
+
+private:
+	void runMap(const std::string& map);
+	void spawnEnemies(World& world) const;
+	void report(const std::string& map, Samples& samples, float seconds, std::size_t entityTicks) const;
+
+
+private:
+	unsigned int mGoombas;
+	unsigned int mTroopas;
+	std::size_t mTicks;
+};
@@ -41,6 +41,8 @@ namespace Category
 		Plant = 1 << 22,
 
 		OutOfWorld = SmallPlayer | BigPlayer | Projectile | Goomba | Troopa | Shell | Mushroom | Star,
-		All = Block | Brick | SoloCoinBox  | CoinsBox | TransformBox | FireBox | ShiftBox | SolidBox | Flower | Plant | StaticCoin | OutOfWorld,
+		Static = Block | Brick | SoloCoinBox | CoinsBox | TransformBox | FireBox | ShiftBox | SolidBox,
+		Dynamic = Flower | Plant | StaticCoin | OutOfWorld,
+		All = Static | Dynamic,
 	};
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+
+#include "SceneNode.hpp"
+
+#include <array>
+#include <cstddef>
+
+
+// Collision handlers of one entity class indexed by (row, category bit). A row
+// is whatever the class switches handlers on, usually its behaviour. Nodes
+// report a single category bit, so resolving a contact is one lookup.
+template <typename T, std::size_t Rows>
+class CollisionTable final
+{
+public:
+	using Handler = void (T::*)(const sf::Vector3f&, SceneNode*);
+
+	static const auto CategoryBits = 32u;
+
+
+public:
+	CollisionTable();
+
+	// the handler for every bit set in categories
+	void set(std::size_t row, unsigned int categories, Handler handler);
+	// the same handler in every row
+	void set(unsigned int categories, Handler handler);
+
+	void resolve(T& object, std::size_t row, const sf::Vector3f& manifold, SceneNode* other) const;
+
+
+private:
+	static std::size_t bitIndex(unsigned int category);
+
+
+private:
+	std::array<std::array<Handler, CategoryBits>, Rows> mHandlers;
+};
+
+#include "CollisionTable.inl"
@@ -0,0 +1,52 @@
+#include <cassert>
+
+
+template <typename T, std::size_t Rows>
+CollisionTable<T, Rows>::CollisionTable()
+	: mHandlers()
+{
+}
+
+template <typename T, std::size_t Rows>
+void CollisionTable<T, Rows>::set(std::size_t row, unsigned int categories, Handler handler)
+{
+	assert(row < Rows);
+
+	for (auto bit = 0u; bit < CategoryBits; ++bit)
+	{
+		if (categories & (1u << bit))
+			mHandlers[row][bit] = handler;
+	}
+}
+
+template <typename T, std::size_t Rows>
+void CollisionTable<T, Rows>::set(unsigned int categories, Handler handler)
+{
+	for (auto row = std::size_t(0u); row < Rows; ++row)
+		set(row, categories, handler);
+}
+
+template <typename T, std::size_t Rows>
+void CollisionTable<T, Rows>::resolve(T& object, std::size_t row, const sf::Vector3f& manifold, SceneNode* other) const
+{
+	assert(row < Rows);
+
+	const auto category = other->getCategory();
+	if (category == 0u) return;
+
+	const auto handler = mHandlers[row][bitIndex(category)];
+	if (handler) (object.*handler)(manifold, other);
+}
+
+template <typename T, std::size_t Rows>
+std::size_t CollisionTable<T, Rows>::bitIndex(unsigned int category)
+{
+	// index of the lowest set bit, de Bruijn multiply
+	static const std::array<unsigned char, 32> Positions
+	{
+		0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+		31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9,
+	};
+
+	return Positions[((category & (0u - category)) * 0x077CB531u) >> 27];
+}
@@ -1,7 +1,9 @@
 #pragma once
 
 
-#include <functional>
+#include "InlineFunction.hpp"
+
+#include <type_traits>
 
 
 class SceneNode;
@@ -9,7 +11,7 @@ class SceneNode;
 
 struct Command
 {
-	using Action = std::function<void(SceneNode&)>;
+	using Action = InlineFunction<void(SceneNode&), 48>;
 
 	Command();
 	Action			action;
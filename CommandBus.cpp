@@ -0,0 +1,80 @@
+#include "CommandBus.hpp"
+#include "Command.hpp"
+#include "SceneNode.hpp"
+
+#include <algorithm>
+
+
+CommandBus::CommandBus()
+	: mMembers()
+	, mTargets()
+	, mStamp(0u)
+{
+}
+
+void CommandBus::attach(SceneNode& node)
+{
+	node.mCommandBus = this;
+	node.mCommandCategories = node.getPossibleCategories();
+
+	const auto categories = node.mCommandCategories;
+	for (auto bit = 0u; bit < CategoryBits; ++bit)
+	{
+		if (categories & (1u << bit))
+			mMembers[bit].emplace_back(&node);
+	}
+
+	for (const auto& child : node.mChildren)
+		attach(*child);
+}
+
+void CommandBus::detach(SceneNode& node)
+{
+	for (const auto& child : node.mChildren)
+		detach(*child);
+
+	// the categories it was listed under, the current ones may differ
+	const auto categories = node.mCommandCategories;
+	for (auto bit = 0u; bit < CategoryBits; ++bit)
+	{
+		if (!(categories & (1u << bit))) continue;
+
+		auto& members = mMembers[bit];
+		members.erase(std::find(members.begin(), members.end(), &node));
+	}
+
+	node.mCommandBus = nullptr;
+	node.mCommandCategories = 0u;
+}
+
+void CommandBus::dispatch(const Command& command)
+{
+	if (++mStamp == 0u)
+	{
+		for (const auto& members : mMembers)
+			for (auto* node : members)
+				node->mCommandStamp = 0u;
+
+		mStamp = 1u;
+	}
+
+	// collect first, actions may attach new nodes while running
+	mTargets.clear();
+	for (auto bit = 0u; bit < CategoryBits; ++bit)
+	{
+		if (!(command.category & (1u << bit))) continue;
+
+		for (auto* node : mMembers[bit])
+		{
+			// a node listed under several bits is commanded once
+			if (node->mCommandStamp == mStamp) continue;
+			if (!(command.category & node->getCategory())) continue;
+
+			node->mCommandStamp = mStamp;
+			mTargets.emplace_back(node);
+		}
+	}
+
+	for (auto* node : mTargets)
+		command.action(*node);
+}
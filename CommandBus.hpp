@@ -0,0 +1,36 @@
+#pragma once
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <array>
+#include <vector>
+
+
+struct Command;
+class SceneNode;
+
+
+// Delivers commands straight to the nodes of matching category. Nodes are
+// kept in one membership list per category bit, maintained by
+// SceneNode::attachChild, detachChild and removeWrecks, so dispatch never
+// walks the scene graph.
+class CommandBus final : private sf::NonCopyable
+{
+	static const auto CategoryBits = 32u;
+
+
+public:
+	CommandBus();
+
+	// register/unregister the node and its whole subtree
+	void attach(SceneNode& node);
+	void detach(SceneNode& node);
+
+	void dispatch(const Command& command);
+
+
+private:
+	std::array<std::vector<SceneNode*>, CategoryBits> mMembers;
+	std::vector<SceneNode*> mTargets;
+	unsigned int mStamp;
+};
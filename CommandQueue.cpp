@@ -1,19 +1,83 @@
 #include "CommandQueue.hpp"
 
+#include <algorithm>
+#include <cassert>
+
+
+CommandQueue::CommandQueue(std::size_t capacity)
+	: mBuffer(capacity)
+	, mHead(0u)
+	, mSize(0u)
+	, mHighWaterMark(0u)
+	, mOverflowCount(0u)
+{
+	assert(capacity > 0u);
+}
 
 void CommandQueue::push(const Command& command)
 {
-	mQueue.push(command);
+	if (auto* slot = acquire())
+		*slot = command;
+}
+
+void CommandQueue::push(Command&& command)
+{
+	if (auto* slot = acquire())
+		*slot = std::move(command);
+}
+
+const Command& CommandQueue::front() const
+{
+	assert(!isEmpty());
+
+	return mBuffer[mHead];
 }
 
-Command CommandQueue::pop()
+void CommandQueue::pop()
 {
-	auto command(mQueue.front());
-	mQueue.pop();
-	return command;
+	assert(!isEmpty());
+
+	mHead = (mHead + 1u) % mBuffer.size();
+	mSize--;
 }
 
 bool CommandQueue::isEmpty() const
 {
-	return mQueue.empty();
-}
\ No newline at end of file
+	return mSize == 0u;
+}
+
+std::size_t CommandQueue::getSize() const
+{
+	return mSize;
+}
+
+std::size_t CommandQueue::getCapacity() const
+{
+	return mBuffer.size();
+}
+
+std::size_t CommandQueue::getHighWaterMark() const
+{
+	return mHighWaterMark;
+}
+
+std::size_t CommandQueue::getOverflowCount() const
+{
+	return mOverflowCount;
+}
+
+Command* CommandQueue::acquire()
+{
+	if (mSize == mBuffer.size())
+	{
+		mOverflowCount++;
+		return nullptr;
+	}
+
+	auto* slot = &mBuffer[(mHead + mSize) % mBuffer.size()];
+
+	mSize++;
+	mHighWaterMark = std::max(mHighWaterMark, mSize);
+
+	return slot;
+}
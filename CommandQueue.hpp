@@ -5,17 +5,38 @@
 
 #include <SFML/System/NonCopyable.hpp>
 
-#include <queue>
+#include <vector>
 
 
+// Fixed capacity ring buffer of commands, storage is allocated once.
+// Commands pushed while full are dropped and counted as overflow.
 class CommandQueue final : private sf::NonCopyable
 {
 public:
+	explicit CommandQueue(std::size_t capacity = 128u);
+
 	void push(const Command& command);
-	Command pop();
+	void push(Command&& command);
+
+	// front() stays valid until pop(), even if commands are pushed meanwhile
+	const Command& front() const;
+	void pop();
 	bool isEmpty() const;
 
+	std::size_t getSize() const;
+	std::size_t getCapacity() const;
+	std::size_t getHighWaterMark() const;
+	std::size_t getOverflowCount() const;
+
+
+private:
+	Command* acquire();
+
 
 private:
-	std::queue<Command> mQueue;
+	std::vector<Command> mBuffer;
+	std::size_t mHead;
+	std::size_t mSize;
+	std::size_t mHighWaterMark;
+	std::size_t mOverflowCount;
 };
@@ -0,0 +1,358 @@
+#include "Compression.hpp"
+
+#include <array>
+
+
+namespace
+{
+	const std::array<unsigned short, 29> LengthBase = {
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const std::array<unsigned char, 29> LengthExtra = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const std::array<unsigned short, 30> DistanceBase = {
+		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const std::array<unsigned char, 30> DistanceExtra = {
+		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+	// canonical huffman code, symbols sorted by code length
+	struct Huffman
+	{
+		std::array<unsigned short, 16> counts;
+		std::array<unsigned short, 288> symbols;
+	};
+
+	void build(Huffman& huffman, const unsigned char* lengths, unsigned int count)
+	{
+		huffman.counts.fill(0u);
+		for (auto i = 0u; i < count; ++i)
+			huffman.counts[lengths[i]]++;
+		huffman.counts[0] = 0u;
+
+		std::array<unsigned short, 16> offsets;
+		offsets[1] = 0u;
+		for (auto i = 1u; i < 15u; ++i)
+			offsets[i + 1] = offsets[i] + huffman.counts[i];
+
+		for (auto i = 0u; i < count; ++i)
+			if (lengths[i] != 0u)
+				huffman.symbols[offsets[lengths[i]]++] = static_cast<unsigned short>(i);
+	}
+
+	class Inflater
+	{
+	public:
+		Inflater(const std::vector<unsigned char>& source, std::size_t position, std::vector<unsigned char>& target)
+			: mSource(source)
+			, mPosition(position)
+			, mBitBuffer(0u)
+			, mBitCount(0u)
+			, mTarget(target)
+			, mFailed(false)
+		{
+		}
+
+		bool run()
+		{
+			auto last = 0u;
+
+			while (!last && !mFailed)
+			{
+				last = bits(1);
+
+				switch (bits(2))
+				{
+				case 0: stored(); break;
+				case 1: fixed(); break;
+				case 2: dynamic(); break;
+				default: mFailed = true; break;
+				}
+			}
+
+			return !mFailed;
+		}
+
+
+	private:
+		unsigned int bits(unsigned int count)
+		{
+			while (mBitCount < count)
+			{
+				if (mPosition >= mSource.size())
+				{
+					mFailed = true;
+					return 0u;
+				}
+
+				mBitBuffer |= static_cast<unsigned long>(mSource[mPosition++]) << mBitCount;
+				mBitCount += 8u;
+			}
+
+			auto value = static_cast<unsigned int>(mBitBuffer & ((1ul << count) - 1ul));
+			mBitBuffer >>= count;
+			mBitCount -= count;
+
+			return value;
+		}
+
+		int decode(const Huffman& huffman)
+		{
+			auto code = 0, first = 0, index = 0;
+
+			for (auto length = 1u; length < 16u; ++length)
+			{
+				code |= static_cast<int>(bits(1));
+
+				const int count = huffman.counts[length];
+				if (code - count < first)
+					return huffman.symbols[index + (code - first)];
+
+				index += count;
+				first = (first + count) << 1;
+				code <<= 1;
+			}
+
+			mFailed = true;
+			return -1;
+		}
+
+		void stored()
+		{
+			mBitBuffer = 0u;
+			mBitCount = 0u;
+
+			if (mPosition + 4u > mSource.size())
+			{
+				mFailed = true;
+				return;
+			}
+
+			auto length = mSource[mPosition] | (mSource[mPosition + 1] << 8);
+			auto complement = mSource[mPosition + 2] | (mSource[mPosition + 3] << 8);
+			mPosition += 4u;
+
+			if (length != (~complement & 0xffff) || mPosition + length > mSource.size())
+			{
+				mFailed = true;
+				return;
+			}
+
+			mTarget.insert(mTarget.end(), mSource.begin() + mPosition, mSource.begin() + mPosition + length);
+			mPosition += length;
+		}
+
+		void fixed()
+		{
+			static const auto Tables = []
+			{
+				std::array<Huffman, 2> tables;
+				std::array<unsigned char, 288> lengths;
+
+				auto i = 0u;
+				for (; i < 144u; ++i) lengths[i] = 8u;
+				for (; i < 256u; ++i) lengths[i] = 9u;
+				for (; i < 280u; ++i) lengths[i] = 7u;
+				for (; i < 288u; ++i) lengths[i] = 8u;
+
+				std::array<unsigned char, 30> distances;
+				distances.fill(5u);
+
+				build(tables[0], lengths.data(), 288u);
+				build(tables[1], distances.data(), 30u);
+
+				return tables;
+			}();
+
+			codes(Tables[0], Tables[1]);
+		}
+
+		void dynamic()
+		{
+			static const std::array<unsigned char, 19> Order = {
+				16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+			auto literalCount = bits(5) + 257u;
+			auto distanceCount = bits(5) + 1u;
+			auto codeCount = bits(4) + 4u;
+
+			if (literalCount > 286u || distanceCount > 30u)
+			{
+				mFailed = true;
+				return;
+			}
+
+			std::array<unsigned char, 320> lengths;
+			lengths.fill(0u);
+
+			for (auto i = 0u; i < codeCount; ++i)
+				lengths[Order[i]] = static_cast<unsigned char>(bits(3));
+
+			Huffman lengthCode;
+			build(lengthCode, lengths.data(), 19u);
+
+			auto index = 0u;
+			while (index < literalCount + distanceCount && !mFailed)
+			{
+				auto symbol = decode(lengthCode);
+
+				if (symbol < 0)
+					return;
+
+				if (symbol < 16)
+				{
+					lengths[index++] = static_cast<unsigned char>(symbol);
+					continue;
+				}
+
+				auto length = 0u;
+				auto repeat = 0u;
+
+				if (symbol == 16)
+				{
+					if (index == 0u)
+					{
+						mFailed = true;
+						return;
+					}
+
+					length = lengths[index - 1];
+					repeat = 3u + bits(2);
+				}
+				else if (symbol == 17)
+					repeat = 3u + bits(3);
+				else
+					repeat = 11u + bits(7);
+
+				if (index + repeat > literalCount + distanceCount)
+				{
+					mFailed = true;
+					return;
+				}
+
+				while (repeat--)
+					lengths[index++] = static_cast<unsigned char>(length);
+			}
+
+			Huffman literals, distances;
+			build(literals, lengths.data(), literalCount);
+			build(distances, lengths.data() + literalCount, distanceCount);
+
+			codes(literals, distances);
+		}
+
+		void codes(const Huffman& literals, const Huffman& distances)
+		{
+			while (!mFailed)
+			{
+				auto symbol = decode(literals);
+
+				if (symbol < 0 || symbol == 256)
+					return;
+
+				if (symbol < 256)
+				{
+					mTarget.push_back(static_cast<unsigned char>(symbol));
+					continue;
+				}
+
+				symbol -= 257;
+				if (symbol >= 29)
+				{
+					mFailed = true;
+					return;
+				}
+
+				auto length = LengthBase[symbol] + bits(LengthExtra[symbol]);
+
+				auto distanceSymbol = decode(distances);
+				if (distanceSymbol < 0 || distanceSymbol >= 30)
+				{
+					mFailed = true;
+					return;
+				}
+
+				auto distance = DistanceBase[distanceSymbol] + bits(DistanceExtra[distanceSymbol]);
+				if (distance > mTarget.size())
+				{
+					mFailed = true;
+					return;
+				}
+
+				// byte by byte, the match may overlap the bytes it produces
+				auto from = mTarget.size() - distance;
+				for (auto i = 0u; i < length; ++i)
+					mTarget.push_back(mTarget[from + i]);
+			}
+		}
+
+
+	private:
+		const std::vector<unsigned char>& mSource;
+		std::size_t mPosition;
+		unsigned long mBitBuffer;
+		unsigned int mBitCount;
+		std::vector<unsigned char>& mTarget;
+		bool mFailed;
+	};
+
+	// returns the offset of the deflate data, or 0 if the header is not understood
+	std::size_t skipHeader(const std::vector<unsigned char>& source)
+	{
+		// gzip: magic, method, flags, mtime, xfl, os, then optional fields
+		if (source.size() >= 10u && source[0] == 0x1f && source[1] == 0x8b)
+		{
+			if (source[2] != 8u)
+				return 0u;
+
+			const auto flags = source[3];
+			auto position = std::size_t(10u);
+
+			if (flags & 0x04) // extra
+			{
+				if (position + 2u > source.size())
+					return 0u;
+				position += 2u + (source[position] | (source[position + 1] << 8));
+			}
+
+			for (auto flag : { 0x08, 0x10 }) // name, comment
+			{
+				if (flags & flag)
+				{
+					while (position < source.size() && source[position] != 0u)
+						++position;
+					++position;
+				}
+			}
+
+			if (flags & 0x02) // header crc
+				position += 2u;
+
+			return position < source.size() ? position : 0u;
+		}
+
+		// zlib: method 8 and a valid header check, preset dictionaries are not supported
+		if (source.size() >= 2u && (source[0] & 0x0f) == 8u && ((source[0] << 8) | source[1]) % 31 == 0 && !(source[1] & 0x20))
+			return 2u;
+
+		return 0u;
+	}
+}
+
+namespace compression
+{
+	bool inflate(const std::vector<unsigned char>& source, std::vector<unsigned char>& target)
+	{
+		target.clear();
+
+		auto position = skipHeader(source);
+		if (position == 0u)
+			return false;
+
+		Inflater inflater(source, position, target);
+
+		return inflater.run();
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+
+#include <vector>
+
+
+namespace compression
+{
+	// Decompresses a zlib (RFC 1950) or gzip (RFC 1952) stream, the wrapper is detected
+	// from the first bytes. Checksums are not verified. Returns false on malformed input.
+	bool inflate(const std::vector<unsigned char>& source, std::vector<unsigned char>& target);
+}
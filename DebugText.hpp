@@ -3,6 +3,7 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 
+#include <stdexcept>
 #include <string>
 #include <sstream>
 
@@ -19,18 +20,22 @@ public:
 
 	DebugText()
 	{
-		if (!font.loadFromFile("Media/arial.ttf"))
-			throw std::runtime_error("can't load fonts");
-
-		text.setFont(font);
 		text.setPosition(20.f, 0.f);
 		text.setString(" ");
 		text.setCharacterSize(10u);
 	}
 
+	// off until a window exists to draw it, headless runs never touch the font
+	void setEnabled(bool flag)
+	{
+		enabled = flag;
+	}
+
 	template <class T>
 	DebugText &operator<<(const T& obj)
 	{
+		if (!enabled) return *this;
+
 		stream << obj;
 		needUpdate = true;
 		return *this;
@@ -41,8 +46,26 @@ public:
 		text.setPosition(pos);
 	}
 
+	void clear()
+	{
+		stream.clear();
+		stream.str({});
+		needUpdate = false;
+	}
+
 	void draw(sf::RenderTarget& target)
 	{
+		if (!enabled) return;
+
+		if (!hasFont)
+		{
+			if (!font.loadFromFile("Media/arial.ttf"))
+				throw std::runtime_error("can't load fonts");
+
+			text.setFont(font);
+			hasFont = true;
+		}
+
 		if (needUpdate)
 		{
 			text.setString(stream.str());
@@ -61,4 +84,6 @@ private:
 	sf::Text text;
 	std::stringstream stream;
 	bool needUpdate = false;
+	bool enabled = false;
+	bool hasFont = false;
 };
\ No newline at end of file
@@ -1,8 +1,9 @@
 #include "Enemy.hpp"
-#include "ResourceHolder.hpp"
+#include "TextureAtlas.hpp"
 #include "CommandQueue.hpp"
 #include "DataTables.hpp"
 #include "Player.hpp"
+#include "SpriteBatch.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 
@@ -14,94 +15,85 @@
 
 namespace
 {
-	using namespace std::placeholders;
 	const static std::vector<EnemyData>& Table = data::initializeEnemyData();
 }
 
 const sf::Vector2f Enemy::Gravity(0.f, 25.f);
 
-Enemy::Enemy(Type type, const TextureHolder& textures)
-	: mType(type)
+Enemy::Enemy(Type type, const TextureHolder& textures, EntityStore& store)
+	: Entity(store)
+	, mType(type)
 	, mBehavors(Air)
-	, mSprite(textures.get(Table[type].texture), Table[type].textureRect)
+	, mSprite(textures, Table[type].texture, Table[type].textureRect)
 	, mFootSenseCount()
 	, mIsMarkedForRemoval(false)
 	, mElapsedTime(sf::Time::Zero)
+	, mDyingTimer(sf::Time::Zero)
 	, mIsDying(false)
 	, mIsCrushed(false)
-	, mUpdateDispatcher()
-	, mUpdater()
-	, mCollisionDispatcher()
-	, mCollision()
+	, mDispatch(&getDispatchTable(type))
 {
-	switch (mType)
-	{
-	case Type::Goomba:
-	case Type::Troopa:
-	{
-		mUpdater = std::bind(&Enemy::behaversUpdate, this, _1);
-		mUpdateDispatcher.emplace_back(Behavors::Ground, std::bind(&Enemy::groundUpdate, this, _1));
-		mUpdateDispatcher.emplace_back(Behavors::Dying, std::bind(&Enemy::dyingUpdate, this, _1));
-		if (mUpdateDispatcher.capacity() > mUpdateDispatcher.size())
-		{
-			mUpdateDispatcher.shrink_to_fit();
-		}
-		mCollision = std::bind(&Enemy::resolveEnemy, this, _1, _2);
-		Dispatcher airCollision({
-			// Tiles
-			{ Category::Brick, std::bind(&Enemy::airObjectsCollision, this, _1, _2) },
-			{ Category::Block, std::bind(&Enemy::airObjectsCollision, this, _1, _2) },
-			{ Category::TransformBox, std::bind(&Enemy::airObjectsCollision, this, _1, _2) },
-			{ Category::CoinsBox, std::bind(&Enemy::airObjectsCollision, this, _1, _2) },
-			{ Category::SoloCoinBox, std::bind(&Enemy::airObjectsCollision, this, _1, _2) },
-			{ Category::SolidBox, std::bind(&Enemy::airObjectsCollision, this, _1, _2) },
-			// Enemies
-			{ Category::Goomba, std::bind(&Enemy::airObjectsCollision, this, _1, _2) },
-			{ Category::Troopa, std::bind(&Enemy::airObjectsCollision, this, _1, _2) },
-			{ Category::Shell, std::bind(&Enemy::airObjectsCollision, this, _1, _2) },
-			// Projectile
-			{ Category::Projectile, std::bind(&Enemy::projectileCollision, this, _1, _2) },
-			// Player
-			{ Category::BigPlayer, std::bind(&Enemy::airPlayerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Enemy::airPlayerCollision, this, _1, _2) },
-		});
-
-		Dispatcher groundCollision({
-			// Tiles
-			{ Category::Brick, std::bind(&Enemy::groundObjectsCollision, this, _1, _2) },
-			{ Category::Block, std::bind(&Enemy::groundObjectsCollision, this, _1, _2) },
-			{ Category::TransformBox, std::bind(&Enemy::groundObjectsCollision, this, _1, _2) },
-			{ Category::CoinsBox, std::bind(&Enemy::groundObjectsCollision, this, _1, _2) },
-			{ Category::SoloCoinBox, std::bind(&Enemy::groundObjectsCollision, this, _1, _2) },
-			{ Category::SolidBox, std::bind(&Enemy::groundObjectsCollision, this, _1, _2) },
-			// Enemies
-			{ Category::Goomba, std::bind(&Enemy::groundObjectsCollision, this, _1, _2) },
-			{ Category::Troopa, std::bind(&Enemy::groundObjectsCollision, this, _1, _2) },
-			{ Category::Shell, std::bind(&Enemy::groundObjectsCollision, this, _1, _2) },
-			// Projectile
-			{ Category::Projectile, std::bind(&Enemy::projectileCollision, this, _1, _2) },
-			// Player
-			{ Category::BigPlayer, std::bind(&Enemy::groundPlayerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Enemy::groundPlayerCollision, this, _1, _2) },
-		});
-
-		mCollisionDispatcher.emplace_back(Behavors::Air, airCollision);
-		mCollisionDispatcher.emplace_back(Behavors::Ground, groundCollision);
-		if (mCollisionDispatcher.capacity() > mCollisionDispatcher.size())
-		{
-			mCollisionDispatcher.shrink_to_fit();
-		}
-	}
-	break;
-	case Type::Plant:
-
-		break;
-	default: break;
-	}
+	setUp();
+}
 
+void Enemy::reset(Type type)
+{
+	// every enemy lives on the same sheet, only the rect changes
+	mType = type;
+	mBehavors = Air;
+	mSprite.setTextureRect(Table[type].textureRect);
+	mSprite.setScale(1.f, 1.f);
+	mFootSenseCount = 0u;
+	mIsMarkedForRemoval = false;
+	mElapsedTime = sf::Time::Zero;
+	mDyingTimer = sf::Time::Zero;
+	mIsDying = false;
+	mIsCrushed = false;
+	mDispatch = &getDispatchTable(type);
+
+	setScale(1.f, 1.f);
+	revive();
 	setUp();
 }
 
+const Enemy::DispatchTable& Enemy::getDispatchTable(Type type)
+{
+	static const auto tables = []()
+	{
+		std::array<DispatchTable, Type::TypeCount> tables{};
+
+		DispatchTable walker{};
+		walker.updater = &Enemy::behaversUpdate;
+		walker.updates = {
+			{ Behavors::Ground, &Enemy::groundUpdate },
+			{ Behavors::Dying, &Enemy::dyingUpdate },
+		};
+
+		// Tiles
+		const auto tiles = Category::Brick | Category::Block | Category::TransformBox
+			| Category::CoinsBox | Category::SoloCoinBox | Category::SolidBox;
+		// Enemies
+		const auto enemies = Category::Goomba | Category::Troopa | Category::Shell;
+		// Player
+		const auto players = Category::BigPlayer | Category::SmallPlayer;
+
+		walker.collisions.set(Behavors::Air, tiles | enemies, &Enemy::airObjectsCollision);
+		walker.collisions.set(Behavors::Air, Category::Projectile, &Enemy::projectileCollision);
+		walker.collisions.set(Behavors::Air, players, &Enemy::airPlayerCollision);
+
+		walker.collisions.set(Behavors::Ground, tiles | enemies, &Enemy::groundObjectsCollision);
+		walker.collisions.set(Behavors::Ground, Category::Projectile, &Enemy::projectileCollision);
+		walker.collisions.set(Behavors::Ground, players, &Enemy::groundPlayerCollision);
+
+		// stomped troopas keep the table they were spawned with as shells
+		tables[Type::Goomba] = walker;
+		tables[Type::Troopa] = walker;
+		return tables;
+	}();
+
+	return tables[type];
+}
+
 void Enemy::setUp()
 {
 	auto bounds = mSprite.getLocalBounds();
@@ -115,6 +107,14 @@ void Enemy::setUp()
 	mFootShape.setOutlineThickness(-0.5f);
 	bounds = mFootShape.getLocalBounds();
 	mFootShape.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
+
+	updateColliders();
+}
+
+void Enemy::updateColliders()
+{
+	setColliders(getTransform().transformRect(mSprite.getGlobalBounds()),
+		getTransform().transformRect(mFootShape.getGlobalBounds()));
 }
 
 unsigned int Enemy::getCategory() const
@@ -130,14 +130,28 @@ unsigned int Enemy::getCategory() const
 	return category[mType];
 }
 
+unsigned int Enemy::getPossibleCategories() const
+{
+	// stomped troopas become shells
+	if (mType == Type::Troopa)
+		return Category::Troopa | Category::Shell;
+
+	return getCategory();
+}
+
 bool Enemy::isMarkedForRemoval() const
 {
 	return mIsMarkedForRemoval;
 }
 
-sf::FloatRect Enemy::getBoundingRect() const
+bool Enemy::isUpdateIndependent() const
+{
+	return true;
+}
+
+bool Enemy::isContinuousCollision() const
 {
-	return getWorldTransform().transformRect(mSprite.getGlobalBounds());
+	return mType == Type::Shell;
 }
 
 void Enemy::die()
@@ -146,6 +160,7 @@ void Enemy::die()
 	vel.y = -230.f; // jump force
 	setVelocity(vel);
 	setScale(1.f, -1.f);
+	updateColliders();
 	mIsDying = true;
 	mBehavors = Dying;
 }
@@ -162,11 +177,11 @@ void Enemy::behaversUpdate(sf::Time dt)
 	else
 		accelerate(Gravity);
 
-	for (const auto& behavor : mUpdateDispatcher)
+	for (const auto& behavor : mDispatch->updates)
 	{
 		if (behavor.first != mBehavors) continue;
 
-		behavor.second(dt);
+		(this->*behavor.second)(dt);
 	}
 }
 
@@ -199,31 +214,27 @@ void Enemy::updateCurrent(sf::Time dt, CommandQueue& commands)
 {
 	if (isDestroyed())
 	{
-		std::cout << "Enemy died\n";
 		mIsMarkedForRemoval = true;
 		return;
 	}
 
-	if (mUpdater) mUpdater(dt);
+	if (mDispatch->updater) (this->*mDispatch->updater)(dt);
+
+	updateColliders();
 
 	if (mIsCrushed) return;
 
 	Entity::updateCurrent(dt, commands);
 }
 
-void Enemy::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
+void Enemy::drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const
 {
-	target.draw(mSprite, states);
+	batch.draw(mSprite, transform);
 #ifdef Debug
-	target.draw(mFootShape, states);
+	batch.drawRectangle(mFootShape, transform);
 #endif // Debug
 }
 
-sf::FloatRect Enemy::getFootSensorBoundingRect() const
-{
-	return getWorldTransform().transformRect(mFootShape.getGlobalBounds());
-}
-
 void Enemy::setFootSenseCount(unsigned int count)
 {
 	mFootSenseCount = count;
@@ -236,23 +247,8 @@ unsigned int Enemy::getFootSenseCount() const
 
 void Enemy::resolve(const sf::Vector3f& manifold, SceneNode* other)
 {
-	if (mCollision) mCollision(manifold, other);
-}
-
-void Enemy::resolveEnemy(const sf::Vector3f& manifold, SceneNode* other)
-{
-	for (const auto& behavor : mCollisionDispatcher)
-	{
-		if (behavor.first != mBehavors) continue;
-
-		for (const auto& collider : behavor.second)
-		{
-			if (collider.first & other->getCategory())
-			{
-				collider.second(manifold, other);
-			}
-		}
-	}
+	mDispatch->collisions.resolve(*this, mBehavors, manifold, other);
+	updateColliders();
 }
 
 void Enemy::airPlayerCollision(const sf::Vector3f& manifold, SceneNode* other)
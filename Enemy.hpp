@@ -3,8 +3,9 @@
 
 #include "Entity.hpp"
 #include "ResourceIdentifiers.hpp"
+#include "AtlasSprite.hpp"
+#include "CollisionTable.hpp"
 
-#include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 
 
@@ -26,33 +27,44 @@ private:
 	{
 		Air,
 		Ground,
-		Dying
+		Dying,
+		BehavorCount
 	};
 
-	using DispatchHolder = std::vector<std::pair<Behavors, Dispatcher>>;
-	using FunctionUpdater = std::function<void(sf::Time)>;
-	using UpdateHolder = std::vector<std::pair<Behavors, FunctionUpdater>>;
+	using UpdateHandler = void (Enemy::*)(sf::Time);
+	using Collisions = CollisionTable<Enemy, BehavorCount>;
+
+	// handlers of one type, built once and shared by all its instances
+	struct DispatchTable
+	{
+		UpdateHandler updater;
+		std::vector<std::pair<Behavors, UpdateHandler>> updates;
+		Collisions collisions;
+	};
 
 
 public:
-	explicit Enemy(Type type, const TextureHolder& textures);
+	explicit Enemy(Type type, const TextureHolder& textures, EntityStore& store);
+
+	// fresh state for an instance recycled by its ObjectPool
+	void reset(Type type);
 
 
 private:
-	void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const override;
+	void drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const override;
 	void updateCurrent(sf::Time dt, CommandQueue& commands) override;
 
-	sf::FloatRect getBoundingRect() const override;
 	bool isMarkedForRemoval() const override;
+	bool isUpdateIndependent() const override;
+	bool isContinuousCollision() const override;
 	unsigned int getCategory() const override;
+	unsigned int getPossibleCategories() const override;
 
-	sf::FloatRect getFootSensorBoundingRect() const override;
 
 	void setFootSenseCount(unsigned int count) override;
 	unsigned int getFootSenseCount() const override;
 
 	void resolve(const sf::Vector3f& manifold, SceneNode* otherType) override;
-	void resolveEnemy(const sf::Vector3f& manifold, SceneNode* other);
 
 	void airPlayerCollision(const sf::Vector3f& manifold, SceneNode* other);
 	void groundPlayerCollision(const sf::Vector3f& manifold, SceneNode* other);
@@ -72,13 +84,17 @@ private:
 	void dyingUpdate(sf::Time dt);
 
 	void setUp();
+	void updateColliders();
+
+	static const DispatchTable& getDispatchTable(Type type);
+
 
 private:
 	static const sf::Vector2f Gravity;
 
 	Type mType;
 	Behavors mBehavors;
-	sf::Sprite mSprite;
+	AtlasSprite mSprite;
 	sf::RectangleShape mFootShape;
 	unsigned int mFootSenseCount;
 	bool mIsMarkedForRemoval;
@@ -88,11 +104,5 @@ private:
 	bool mIsDying;
 	bool mIsCrushed;
 
-	UpdateHolder mUpdateDispatcher;
-	FunctionUpdater mUpdater;
-
-	DispatchHolder mCollisionDispatcher;
-	Function mCollision;
-	Dispatcher mBehaversCollision;
-	//DeathHolder mDeathDispatcher;
+	const DispatchTable* mDispatch;
 };
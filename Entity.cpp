@@ -1,26 +1,61 @@
 #include "Entity.hpp"
 #include "Utility.hpp"
 
-Entity::Entity(int hitpoints)
-	: mVelocity()
-	, mHitpoints(hitpoints)
+#include <cassert>
+
+Entity::Entity(EntityStore& store, int hitpoints)
+	: mStore(store)
+	, mHandle(store.create(*this, hitpoints))
+{
+	// integrate moves the entity without going through the setters
+	disableWorldTransformCache();
+}
+
+Entity::~Entity()
+{
+	mStore.destroy(mHandle);
+}
+
+void Entity::setPosition(float x, float y)
+{
+	setPosition(sf::Vector2f(x, y));
+}
+
+void Entity::setPosition(const sf::Vector2f& position)
+{
+	mStore.getPosition(mHandle) = position;
+}
+
+void Entity::move(float offsetX, float offsetY)
+{
+	move(sf::Vector2f(offsetX, offsetY));
+}
+
+void Entity::move(const sf::Vector2f& offset)
+{
+	mStore.getPosition(mHandle) += offset;
+}
+
+const sf::Vector2f& Entity::getPosition() const
 {
+	return mStore.getPosition(mHandle);
 }
 
 void Entity::setVelocity(sf::Vector2f velocity)
 {
-	mVelocity = velocity;
+	mStore.getVelocity(mHandle) = velocity;
 }
 
 void Entity::setVelocity(float vx, float vy)
 {
-	mVelocity.x = vx;
-	mVelocity.y = vy;
+	auto& velocity = mStore.getVelocity(mHandle);
+	velocity.x = vx;
+	velocity.y = vy;
 }
 
 void Entity::destroy()
 {
-	mHitpoints = 0;
+	mStore.getHitpoints(mHandle) = 0;
 }
 
 void Entity::remove()
@@ -30,23 +65,58 @@ void Entity::remove()
 
 bool Entity::isDestroyed() const
 {
-	return mHitpoints <= 0;
+	return mStore.getHitpoints(mHandle) <= 0;
+}
+
+sf::FloatRect Entity::getBoundingRect() const
+{
+	return mStore.getBoundingRect(mHandle);
+}
+
+sf::FloatRect Entity::getFootSensorBoundingRect() const
+{
+	return mStore.getFootSensorBoundingRect(mHandle);
 }
 
 void Entity::updateCurrent(sf::Time dt, CommandQueue&)
 {
-	auto speed = utility::length(mVelocity) * dt.asSeconds();
-	auto velocity = utility::normalise(mVelocity) * speed;
+	const auto& velocity = mStore.getVelocity(mHandle);
+
+	auto speed = utility::length(velocity) * dt.asSeconds();
+	auto direction = utility::normalise(velocity) * speed;
 
-	move(velocity);
+	// applied with every other step by EntityStore::integrate after the update pass
+	mStore.getStep(mHandle) = direction;
 }
 
 void Entity::accelerate(sf::Vector2f velocity)
 {
-	mVelocity += velocity;
+	mStore.getVelocity(mHandle) += velocity;
+}
+
+void Entity::revive(int hitpoints)
+{
+	mStore.getHitpoints(mHandle) = hitpoints;
+	mStore.getVelocity(mHandle) = sf::Vector2f();
+	mStore.getStep(mHandle) = sf::Vector2f();
 }
 
 sf::Vector2f Entity::getVelocity() const
 {
-	return mVelocity;
-}
\ No newline at end of file
+	return mStore.getVelocity(mHandle);
+}
+
+void Entity::setColliders(const sf::FloatRect& bounds, const sf::FloatRect& sensor)
+{
+	mStore.setColliders(mHandle, bounds, sensor);
+}
+
+sf::Transform Entity::getLocalTransform() const
+{
+	assert(sf::Transformable::getPosition() == sf::Vector2f());
+
+	sf::Transform transform;
+	transform.translate(getPosition());
+
+	return transform * getTransform();
+}
@@ -1,12 +1,23 @@
 #pragma once
 
 #include "SceneNode.hpp"
+#include "EntityStore.hpp"
 
 
+// position, velocity, hitpoints, the last step and the collider rects live
+// in the store of the entity's World, the entity keeps its handle
 class Entity : public SceneNode
 {
 public:
-	explicit Entity(int hitpoints = 1);
+	explicit Entity(EntityStore& store, int hitpoints = 1);
+	~Entity() override;
+
+	// the position lives in the store, the sf::Transformable one stays at the origin
+	void setPosition(float x, float y);
+	void setPosition(const sf::Vector2f& position);
+	void move(float offsetX, float offsetY);
+	void move(const sf::Vector2f& offset);
+	const sf::Vector2f& getPosition() const;
 
 	void setVelocity(float vx, float vy) override;
 	void setVelocity(sf::Vector2f velocity) override;
@@ -16,16 +27,27 @@ public:
 
 	bool isDestroyed() const override;
 
+	sf::FloatRect getBoundingRect() const override;
+	sf::FloatRect getFootSensorBoundingRect() const override;
+
 
 protected:
+	// records this tick's step, the store moves the entity once the whole graph is updated
 	void updateCurrent(sf::Time dt, CommandQueue& commands) override;
 
 	void accelerate(sf::Vector2f velocity);
+	// back to life for a pooled instance, velocity and last step cleared
+	void revive(int hitpoints = 1);
 
 	sf::Vector2f getVelocity() const override;
 
+	// outline and foot sensor in local space, call whenever the sprite or the own transform changes
+	void setColliders(const sf::FloatRect& bounds, const sf::FloatRect& sensor = {});
+
+	sf::Transform getLocalTransform() const override;
+
 
 private:
-	sf::Vector2f mVelocity;
-	int mHitpoints;
+	EntityStore& mStore;
+	EntityStore::Handle mHandle;
 };
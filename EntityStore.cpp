@@ -0,0 +1,191 @@
+#include "EntityStore.hpp"
+#include "Utility.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+
+EntityStore::EntityStore()
+	: mOwners()
+	, mPositions()
+	, mVelocities()
+	, mHitpoints()
+	, mSteps()
+	, mColliders()
+	, mSensors()
+	, mIndices()
+	, mHandles()
+	, mFreeHandles()
+{
+}
+
+EntityStore::Handle EntityStore::create(Entity& owner, int hitpoints)
+{
+	Handle handle;
+
+	if (mFreeHandles.empty())
+	{
+		handle = mIndices.size();
+		mIndices.push_back(0u);
+	}
+	else
+	{
+		handle = mFreeHandles.back();
+		mFreeHandles.pop_back();
+	}
+
+	mIndices[handle] = mOwners.size();
+	mHandles.push_back(handle);
+
+	mOwners.push_back(&owner);
+	mPositions.emplace_back();
+	mVelocities.emplace_back();
+	mHitpoints.push_back(hitpoints);
+	mSteps.emplace_back();
+	mColliders.emplace_back();
+	mSensors.emplace_back();
+
+	return handle;
+}
+
+void EntityStore::destroy(Handle handle)
+{
+	assert(handle < mIndices.size());
+
+	const auto index = mIndices[handle];
+	const auto last = mOwners.size() - 1u;
+
+	mOwners[index] = mOwners[last];
+	mPositions[index] = mPositions[last];
+	mVelocities[index] = mVelocities[last];
+	mHitpoints[index] = mHitpoints[last];
+	mSteps[index] = mSteps[last];
+	mColliders[index] = mColliders[last];
+	mSensors[index] = mSensors[last];
+	mHandles[index] = mHandles[last];
+	mIndices[mHandles[index]] = index;
+
+	mOwners.pop_back();
+	mPositions.pop_back();
+	mVelocities.pop_back();
+	mHitpoints.pop_back();
+	mSteps.pop_back();
+	mColliders.pop_back();
+	mSensors.pop_back();
+	mHandles.pop_back();
+
+	mFreeHandles.push_back(handle);
+}
+
+std::size_t EntityStore::size() const
+{
+	return mOwners.size();
+}
+
+sf::Vector2f& EntityStore::getPosition(Handle handle)
+{
+	return mPositions[mIndices[handle]];
+}
+
+const sf::Vector2f& EntityStore::getPosition(Handle handle) const
+{
+	return mPositions[mIndices[handle]];
+}
+
+sf::Vector2f& EntityStore::getVelocity(Handle handle)
+{
+	return mVelocities[mIndices[handle]];
+}
+
+const sf::Vector2f& EntityStore::getVelocity(Handle handle) const
+{
+	return mVelocities[mIndices[handle]];
+}
+
+int& EntityStore::getHitpoints(Handle handle)
+{
+	return mHitpoints[mIndices[handle]];
+}
+
+int EntityStore::getHitpoints(Handle handle) const
+{
+	return mHitpoints[mIndices[handle]];
+}
+
+sf::Vector2f& EntityStore::getStep(Handle handle)
+{
+	return mSteps[mIndices[handle]];
+}
+
+void EntityStore::setColliders(Handle handle, const sf::FloatRect& bounds, const sf::FloatRect& sensor)
+{
+	const auto index = mIndices[handle];
+
+	mColliders[index] = bounds;
+	mSensors[index] = sensor;
+}
+
+sf::FloatRect EntityStore::getBoundingRect(Handle handle) const
+{
+	const auto index = mIndices[handle];
+
+	return utility::translate(mColliders[index], mPositions[index]);
+}
+
+sf::FloatRect EntityStore::getFootSensorBoundingRect(Handle handle) const
+{
+	const auto index = mIndices[handle];
+
+	return utility::translate(mSensors[index], mPositions[index]);
+}
+
+const std::vector<Entity*>& EntityStore::getOwners() const
+{
+	return mOwners;
+}
+
+std::vector<sf::Vector2f>& EntityStore::getPositions()
+{
+	return mPositions;
+}
+
+const std::vector<sf::Vector2f>& EntityStore::getPositions() const
+{
+	return mPositions;
+}
+
+const std::vector<sf::Vector2f>& EntityStore::getVelocities() const
+{
+	return mVelocities;
+}
+
+const std::vector<int>& EntityStore::getHitpoints() const
+{
+	return mHitpoints;
+}
+
+const std::vector<sf::Vector2f>& EntityStore::getSteps() const
+{
+	return mSteps;
+}
+
+const std::vector<sf::FloatRect>& EntityStore::getColliders() const
+{
+	return mColliders;
+}
+
+const std::vector<sf::FloatRect>& EntityStore::getSensors() const
+{
+	return mSensors;
+}
+
+void EntityStore::clearSteps()
+{
+	std::fill(mSteps.begin(), mSteps.end(), sf::Vector2f());
+}
+
+void EntityStore::integrate()
+{
+	for (auto i = std::size_t(0u); i < mPositions.size(); ++i)
+		mPositions[i] += mSteps[i];
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+#include <vector>
+
+
+class Entity;
+
+// Dense per-entity component arrays, Entity objects are thin views into them.
+// Index i of every array is the same entity, removal moves the last entity
+// into the hole, so systems can walk the arrays linearly. Handles stay valid
+// until the entity is destroyed.
+// Each World owns one store and hands it to the entities it creates.
+// Entities sit directly under the identity transformed layers, so a stored
+// position is the world position and a collider offset by it is world space.
+class EntityStore final : private sf::NonCopyable
+{
+public:
+	using Handle = std::size_t;
+
+
+public:
+	EntityStore();
+
+	Handle create(Entity& owner, int hitpoints);
+	void destroy(Handle handle);
+
+	std::size_t size() const;
+
+	sf::Vector2f& getPosition(Handle handle);
+	const sf::Vector2f& getPosition(Handle handle) const;
+	sf::Vector2f& getVelocity(Handle handle);
+	const sf::Vector2f& getVelocity(Handle handle) const;
+	int& getHitpoints(Handle handle);
+	int getHitpoints(Handle handle) const;
+	// displacement of the last update, continuous collision sweeps it back
+	sf::Vector2f& getStep(Handle handle);
+	// outline and foot sensor relative to the position
+	void setColliders(Handle handle, const sf::FloatRect& bounds, const sf::FloatRect& sensor);
+	sf::FloatRect getBoundingRect(Handle handle) const;
+	sf::FloatRect getFootSensorBoundingRect(Handle handle) const;
+
+	// dense arrays for systems
+	const std::vector<Entity*>& getOwners() const;
+	std::vector<sf::Vector2f>& getPositions();
+	const std::vector<sf::Vector2f>& getPositions() const;
+	const std::vector<sf::Vector2f>& getVelocities() const;
+	const std::vector<int>& getHitpoints() const;
+	const std::vector<sf::Vector2f>& getSteps() const;
+	const std::vector<sf::FloatRect>& getColliders() const;
+	const std::vector<sf::FloatRect>& getSensors() const;
+	// before an update pass, entities that skip their move this tick report no step
+	void clearSteps();
+	// after the update pass, moves every entity by the step it recorded
+	void integrate();
+
+
+private:
+	std::vector<Entity*> mOwners;
+	std::vector<sf::Vector2f> mPositions;
+	std::vector<sf::Vector2f> mVelocities;
+	std::vector<int> mHitpoints;
+	std::vector<sf::Vector2f> mSteps;
+	std::vector<sf::FloatRect> mColliders;
+	std::vector<sf::FloatRect> mSensors;
+
+	std::vector<std::size_t> mIndices;	// handle to dense index
+	std::vector<Handle> mHandles;		// dense index to handle
+	std::vector<Handle> mFreeHandles;
+};
@@ -1,13 +1,18 @@
 #include "Game.hpp"
 #include "DebugText.hpp"
+#include "Profiler.hpp"
 #include <SFML/Window/Event.hpp>
 
+#include <iostream>
+
 
 Game::Game(const std::string& title, unsigned width, unsigned height)
 	: mWindow({ width, height }, title)
 	, mWorld(mWindow)
 	, mTitle(title)
 	, mFullScreen(false)
+	, mProfilerOverlay()
+	, mShowProfiler(false)
 {
 	mWindow.setKeyRepeatEnabled(false);
 	//mWindow.setVerticalSyncEnabled(true); // problem with text-debug
@@ -72,6 +77,15 @@ void Game::processEvents()
 
 				mWindow.create(videoMode, mTitle, style);
 			}
+
+			else if (event.key.code == sf::Keyboard::F2)
+				mShowProfiler = !mShowProfiler;
+
+			else if (event.key.code == sf::Keyboard::F3)
+			{
+				if (Profiler::instance().exportTrace("trace.json"))
+					std::cout << "profile written to trace.json\n";
+			}
 		}
 		mWorld.handleEvent(event);
 	}
@@ -87,5 +101,13 @@ void Game::render()
 	const static auto color = sf::Color(90, 140, 255);
 	mWindow.clear(color);
 	mWorld.draw();
+
+	if (mShowProfiler)
+	{
+		mProfilerOverlay.update();
+		mWindow.setView(mWindow.getDefaultView());
+		mWindow.draw(mProfilerOverlay);
+	}
+
 	mWindow.display();
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "World.hpp"
+#include "ProfilerOverlay.hpp"
 
 #include <SFML/Graphics/RenderWindow.hpp>
 
@@ -23,4 +24,6 @@ private:
 	World mWorld;
 	std::string mTitle;
 	bool mFullScreen;
+	ProfilerOverlay mProfilerOverlay;
+	bool mShowProfiler;
 };
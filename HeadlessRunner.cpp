@@ -0,0 +1,89 @@
+#include "HeadlessRunner.hpp"
+#include "DebugText.hpp"
+
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include <map>
+
+
+namespace
+{
+	const static std::map<std::string, PlayerController::Action> Actions =
+	{
+		{ "left", PlayerController::MoveLeft },
+		{ "right", PlayerController::MoveRight },
+		{ "jump", PlayerController::Jumping },
+		{ "fire", PlayerController::Fire },
+	};
+}
+
+
+HeadlessRunner::HeadlessRunner(const std::string& map, sf::Vector2f viewSize, const std::string& script)
+	: mWorld(viewSize, map)
+	, mScript()
+{
+	if (!script.empty())
+		loadScript(script);
+}
+
+void HeadlessRunner::loadScript(const std::string& filename)
+{
+	std::ifstream file(filename);
+	if (!file)
+		throw std::runtime_error("can't load input script " + filename);
+
+	std::string line;
+	for (auto number = 1u; std::getline(file, line); ++number)
+	{
+		line = line.substr(0, line.find('#'));
+
+		std::istringstream stream(line);
+		std::size_t tick;
+		std::string action, state;
+
+		if (!(stream >> tick))
+			continue; // blank or comment
+
+		if (!(stream >> action >> state) || !Actions.count(action) || (state != "press" && state != "release"))
+			throw std::runtime_error(filename + ":" + std::to_string(number) + ": bad input event");
+
+		mScript.push_back({ tick, Actions.at(action), state == "press" });
+	}
+
+	std::stable_sort(mScript.begin(), mScript.end(), [](const auto& lhs, const auto& rhs)
+	{
+		return lhs.tick < rhs.tick;
+	});
+}
+
+void HeadlessRunner::run(std::size_t ticks)
+{
+	const auto TimePerFrame = sf::seconds(1 / 60.f);
+
+	auto event = mScript.cbegin();
+
+	sf::Clock clock;
+	for (auto tick = 0u; tick < ticks; ++tick)
+	{
+		for (; event != mScript.cend() && event->tick == tick; ++event)
+			mWorld.handleAction(event->action, event->pressed);
+
+		mWorld.update(TimePerFrame);
+
+		debug.clear(); // nothing draws it, so drop the text every tick
+	}
+	auto elapsed = clock.getElapsedTime().asSeconds();
+
+	std::cout << "ticks: " << ticks << "\n"
+			  << "seconds: " << elapsed << "\n"
+			  << "ticks per second: " << (elapsed > 0.f ? ticks / elapsed : 0.f) << "\n"
+			  << "command queue high water: " << mWorld.getCommandQueue().getHighWaterMark()
+			  << " / " << mWorld.getCommandQueue().getCapacity()
+			  << ", overflow: " << mWorld.getCommandQueue().getOverflowCount() << "\n"
+			  << "pooled entities allocated: " << mWorld.getPoolAllocationCount() << std::endl;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "World.hpp"
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <string>
+#include <vector>
+
+
+// Runs World without a window, advancing fixed 1/60 s steps as fast as
+// the CPU allows while replaying a scripted input stream.
+//
+// Script format, one event per line ('#' starts a comment):
+//     <tick> <left|right|jump|fire> <press|release>
+class HeadlessRunner final : private sf::NonCopyable
+{
+	struct InputEvent
+	{
+		std::size_t tick;
+		PlayerController::Action action;
+		bool pressed;
+	};
+
+
+public:
+	HeadlessRunner(const std::string& map, sf::Vector2f viewSize, const std::string& script = "");
+
+	void run(std::size_t ticks);
+
+
+private:
+	void loadScript(const std::string& filename);
+
+
+private:
+	World mWorld;
+	std::vector<InputEvent> mScript;
+};
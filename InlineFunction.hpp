@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+template <typename Signature, std::size_t Capacity>
+class InlineFunction;
+
+
+// Callable wrapper with fixed inline storage, a std::function that never
+// allocates. Targets that don't fit in Capacity bytes fail to compile.
+template <typename Result, typename... Args, std::size_t Capacity>
+class InlineFunction<Result(Args...), Capacity> final
+{
+	enum Operation
+	{
+		Copy,
+		Move,
+		Destroy
+	};
+
+	using Invoker = Result(*)(void*, Args&&...);
+	using Manager = void(*)(Operation, void*, void*);
+
+
+public:
+	InlineFunction() noexcept;
+
+	template
+	<
+		typename Function,
+		typename = std::enable_if_t<!std::is_same<std::decay_t<Function>, InlineFunction>::value>
+	>
+	InlineFunction(Function function);
+
+	InlineFunction(const InlineFunction& other);
+	InlineFunction(InlineFunction&& other) noexcept;
+	InlineFunction& operator=(const InlineFunction& other);
+	InlineFunction& operator=(InlineFunction&& other) noexcept;
+	~InlineFunction();
+
+	Result operator()(Args... args) const;
+	explicit operator bool() const noexcept;
+
+
+private:
+	void reset() noexcept;
+
+	template <typename Function>
+	static Result invoke(void* target, Args&&... args);
+
+	template <typename Function>
+	static void manage(Operation operation, void* destination, void* source);
+
+
+private:
+	mutable std::aligned_storage_t<Capacity, alignof(std::max_align_t)> mStorage;
+	Invoker mInvoker;
+	Manager mManager;
+};
+
+#include "InlineFunction.inl"
@@ -0,0 +1,132 @@
+#include <cassert>
+
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>::InlineFunction() noexcept
+	: mStorage()
+	, mInvoker(nullptr)
+	, mManager(nullptr)
+{
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+template <typename Function, typename>
+InlineFunction<Result(Args...), Capacity>::InlineFunction(Function function)
+	: mStorage()
+	, mInvoker(&invoke<Function>)
+	, mManager(&manage<Function>)
+{
+	static_assert(sizeof(Function) <= Capacity, "InlineFunction - target doesn't fit in the inline storage");
+	static_assert(alignof(Function) <= alignof(std::max_align_t), "InlineFunction - target is over-aligned");
+
+	new (&mStorage) Function(std::move(function));
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>::InlineFunction(const InlineFunction& other)
+	: mStorage()
+	, mInvoker(other.mInvoker)
+	, mManager(other.mManager)
+{
+	if (mManager)
+		mManager(Copy, &mStorage, &other.mStorage);
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>::InlineFunction(InlineFunction&& other) noexcept
+	: mStorage()
+	, mInvoker(other.mInvoker)
+	, mManager(other.mManager)
+{
+	if (mManager)
+		mManager(Move, &mStorage, &other.mStorage);
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>& InlineFunction<Result(Args...), Capacity>::operator=(const InlineFunction& other)
+{
+	if (this != &other)
+	{
+		reset();
+
+		if (other.mManager)
+			other.mManager(Copy, &mStorage, &other.mStorage);
+
+		mInvoker = other.mInvoker;
+		mManager = other.mManager;
+	}
+
+	return *this;
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>& InlineFunction<Result(Args...), Capacity>::operator=(InlineFunction&& other) noexcept
+{
+	if (this != &other)
+	{
+		reset();
+
+		if (other.mManager)
+			other.mManager(Move, &mStorage, &other.mStorage);
+
+		mInvoker = other.mInvoker;
+		mManager = other.mManager;
+	}
+
+	return *this;
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>::~InlineFunction()
+{
+	reset();
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+Result InlineFunction<Result(Args...), Capacity>::operator()(Args... args) const
+{
+	assert(mInvoker);
+
+	return mInvoker(&mStorage, std::forward<Args>(args)...);
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+InlineFunction<Result(Args...), Capacity>::operator bool() const noexcept
+{
+	return mInvoker != nullptr;
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+void InlineFunction<Result(Args...), Capacity>::reset() noexcept
+{
+	if (mManager)
+		mManager(Destroy, &mStorage, nullptr);
+
+	mInvoker = nullptr;
+	mManager = nullptr;
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+template <typename Function>
+Result InlineFunction<Result(Args...), Capacity>::invoke(void* target, Args&&... args)
+{
+	return (*static_cast<Function*>(target))(std::forward<Args>(args)...);
+}
+
+template <typename Result, typename... Args, std::size_t Capacity>
+template <typename Function>
+void InlineFunction<Result(Args...), Capacity>::manage(Operation operation, void* destination, void* source)
+{
+	switch (operation)
+	{
+	case Copy:
+		new (destination) Function(*static_cast<const Function*>(source));
+		break;
+	case Move:
+		new (destination) Function(std::move(*static_cast<Function*>(source)));
+		break;
+	case Destroy:
+		static_cast<Function*>(destination)->~Function();
+		break;
+	}
+}
@@ -1,11 +1,11 @@
 #include "Item.hpp"
 #include "DataTables.hpp"
-#include "ResourceHolder.hpp"
+#include "TextureAtlas.hpp"
+#include "SpriteBatch.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 
 #include <array>
-#include <iostream>
 
 #define Debug
 
@@ -16,120 +16,36 @@ namespace
 
 const sf::Vector2f Item::Gravity(0.f, 25.f);
 
-Item::Item(Type type, const TextureHolder& textures)
-	: mType(type)
+Item::Item(Type type, const TextureHolder& textures, EntityStore& store)
+	: Entity(store)
+	, mType(type)
 	, mBehavors(None)
-	, mSprite(textures.get(Table[type].texture), Table[type].textureRect)
+	, mSprite(textures, Table[type].texture, Table[type].textureRect)
 	, mFootSenseCount()
 	, mIsMarkedForRemoval(false)
 	, mElapsedTime(sf::Time::Zero)
-	, mCollisionDispatcher()
-	, mCollision()
-	, mBehaversCollision()
-	, mUpdateDispatcher()
-	, mUpdater()
+	, mDispatch(&getDispatchTable(type))
 {
-	using namespace std::placeholders;
+	setUp();
+}
 
-	switch (mType)
-	{
-	case Type::StaticCoin:
-		mCollision = std::bind(&Item::collisions, this, _1, _2);
-		mBehaversCollision.insert({
-			{ Category::BigPlayer, std::bind(&Item::playerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Item::playerCollision, this, _1, _2) },
-		});
-		break;
-	case Type::MoveableCoin:
-		mUpdater = std::bind(&Item::moveableCoinUpdate, this, _1);
-
-		break;
-	case Type::Mushroom:
-	{
-		mUpdater = std::bind(&Item::behaversUpdate, this, _1);
-		mUpdateDispatcher.emplace_back(Behavors::None, std::bind(&Item::mushroomNoneUpdate, this, _1));
-		mUpdateDispatcher.emplace_back(Behavors::Air, std::bind(&Item::airUpdate, this, _1));
-		mUpdateDispatcher.emplace_back(Behavors::Ground, std::bind(&Item::mushroomGroundUpdate, this, _1));
-		if (mUpdateDispatcher.capacity() > mUpdateDispatcher.size())
-		{
-			mUpdateDispatcher.shrink_to_fit();
-		}
-		mCollision = std::bind(&Item::resolveMushroom, this, _1, _2);
-		Dispatcher airCollision({
-			// Tiles
-			{ Category::Brick, std::bind(&Item::airMushroomObjectsCollision, this, _1, _2) },
-			{ Category::Block, std::bind(&Item::airMushroomObjectsCollision, this, _1, _2) },
-			{ Category::TransformBox, std::bind(&Item::airMushroomObjectsCollision, this, _1, _2) },
-			{ Category::CoinsBox, std::bind(&Item::airMushroomObjectsCollision, this, _1, _2) },
-			{ Category::SoloCoinBox, std::bind(&Item::airMushroomObjectsCollision, this, _1, _2) },
-			{ Category::SolidBox, std::bind(&Item::airMushroomObjectsCollision, this, _1, _2) },
-			// Enemies
-			{ Category::Goomba, std::bind(&Item::airMushroomObjectsCollision, this, _1, _2) },
-			// Player
-			{ Category::BigPlayer, std::bind(&Item::playerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Item::playerCollision, this, _1, _2) },
-		});
-
-		Dispatcher groundCollision({
-			// Tiles
-			{ Category::Brick, std::bind(&Item::groundMushroomObjectsCollision, this, _1, _2) },
-			{ Category::Block, std::bind(&Item::groundMushroomObjectsCollision, this, _1, _2) },
-			{ Category::TransformBox, std::bind(&Item::groundMushroomObjectsCollision, this, _1, _2) },
-			{ Category::CoinsBox, std::bind(&Item::groundMushroomObjectsCollision, this, _1, _2) },
-			{ Category::SoloCoinBox, std::bind(&Item::groundMushroomObjectsCollision, this, _1, _2) },
-			{ Category::SolidBox, std::bind(&Item::groundMushroomObjectsCollision, this, _1, _2) },
-			// Enemies
-			{ Category::Goomba, std::bind(&Item::groundMushroomObjectsCollision, this, _1, _2) },
-			// Player
-			{ Category::BigPlayer, std::bind(&Item::playerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Item::playerCollision, this, _1, _2) },
-		});
-
-		mCollisionDispatcher.emplace_back(Behavors::Air, airCollision);
-		mCollisionDispatcher.emplace_back(Behavors::Ground, groundCollision);
-		if (mCollisionDispatcher.capacity() > mCollisionDispatcher.size())
-		{
-			mCollisionDispatcher.shrink_to_fit();
-		}
-	}
-		break;
-	case Type::Flower:
-		mUpdater = std::bind(&Item::flowerUpdate, this, _1);
-		mCollision = std::bind(&Item::collisions, this, _1, _2);
-		mBehaversCollision.insert({
-			{ Category::BigPlayer, std::bind(&Item::playerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Item::playerCollision, this, _1, _2) },
-		});
-		break;
-	case Type::Star:
-	{
-		mUpdater = std::bind(&Item::behaversUpdate, this, _1);
-		mUpdateDispatcher.emplace_back(Behavors::None, std::bind(&Item::starNoneUpdate, this, _1));
-		mUpdateDispatcher.emplace_back(Behavors::Air, std::bind(&Item::airUpdate, this, _1));
-		if (mUpdateDispatcher.capacity() > mUpdateDispatcher.size())
-		{
-			mUpdateDispatcher.shrink_to_fit();
-		}
-		mCollision = std::bind(&Item::collisions, this, _1, _2);
-		mBehaversCollision.insert({
-			// Tiles
-			{ Category::Brick, std::bind(&Item::starObjectsCollision, this, _1, _2) },
-			{ Category::Block, std::bind(&Item::starObjectsCollision, this, _1, _2) },
-			{ Category::TransformBox, std::bind(&Item::starObjectsCollision, this, _1, _2) },
-			{ Category::CoinsBox, std::bind(&Item::starObjectsCollision, this, _1, _2) },
-			{ Category::SoloCoinBox, std::bind(&Item::starObjectsCollision, this, _1, _2) },
-			{ Category::SolidBox, std::bind(&Item::starObjectsCollision, this, _1, _2) },
-			// Enemies
-			{ Category::Goomba, std::bind(&Item::starObjectsCollision, this, _1, _2) },
-			// Player
-			{ Category::BigPlayer, std::bind(&Item::playerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Item::playerCollision, this, _1, _2) },
-		});
-	}
-	break;
-	default: break;
-	}
+void Item::reset(Type type)
+{
+	// every item lives on the same sheet, only the rect changes
+	mType = type;
+	mBehavors = None;
+	mSprite.setTextureRect(Table[type].textureRect);
+	mFootSenseCount = 0u;
+	mIsMarkedForRemoval = false;
+	mElapsedTime = sf::Time::Zero;
+	mDispatch = &getDispatchTable(type);
+
+	revive();
+	setUp();
+}
 
+void Item::setUp()
+{
 	auto bounds = mSprite.getLocalBounds();
 	mSprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
 
@@ -141,6 +57,63 @@ Item::Item(Type type, const TextureHolder& textures)
 	mFootShape.setOutlineThickness(-0.5f);
 	bounds = mFootShape.getLocalBounds();
 	mFootShape.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
+
+	// animation frames share one size, the outline is fixed from here on
+	updateColliders();
+}
+
+void Item::updateColliders()
+{
+	setColliders(getTransform().transformRect(mSprite.getGlobalBounds()),
+		getTransform().transformRect(mFootShape.getGlobalBounds()));
+}
+
+const Item::DispatchTable& Item::getDispatchTable(Type type)
+{
+	static const auto tables = []()
+	{
+		std::array<DispatchTable, Type::TypeCount> tables{};
+
+		const auto tiles = Category::Brick | Category::Block | Category::TransformBox
+			| Category::CoinsBox | Category::SoloCoinBox | Category::SolidBox;
+		const auto players = Category::BigPlayer | Category::SmallPlayer;
+
+		auto& staticCoin = tables[Type::StaticCoin];
+		staticCoin.collisions.set(players, &Item::playerCollision);
+
+		auto& moveableCoin = tables[Type::MoveableCoin];
+		moveableCoin.updater = &Item::moveableCoinUpdate;
+
+		auto& mushroom = tables[Type::Mushroom];
+		mushroom.updater = &Item::behaversUpdate;
+		mushroom.updates = {
+			{ Behavors::None, &Item::mushroomNoneUpdate },
+			{ Behavors::Air, &Item::airUpdate },
+			{ Behavors::Ground, &Item::mushroomGroundUpdate },
+		};
+		// no handlers in None, the mushroom is still rising out of its box
+		mushroom.collisions.set(Behavors::Air, tiles | Category::Goomba, &Item::airMushroomObjectsCollision);
+		mushroom.collisions.set(Behavors::Air, players, &Item::playerCollision);
+		mushroom.collisions.set(Behavors::Ground, tiles | Category::Goomba, &Item::groundMushroomObjectsCollision);
+		mushroom.collisions.set(Behavors::Ground, players, &Item::playerCollision);
+
+		auto& flower = tables[Type::Flower];
+		flower.updater = &Item::flowerUpdate;
+		flower.collisions.set(players, &Item::playerCollision);
+
+		auto& star = tables[Type::Star];
+		star.updater = &Item::behaversUpdate;
+		star.updates = {
+			{ Behavors::None, &Item::starNoneUpdate },
+			{ Behavors::Air, &Item::airUpdate },
+		};
+		star.collisions.set(tiles | Category::Goomba, &Item::starObjectsCollision);
+		star.collisions.set(players, &Item::playerCollision);
+
+		return tables;
+	}();
+
+	return tables[type];
 }
 
 unsigned int Item::getCategory() const
@@ -162,9 +135,9 @@ bool Item::isMarkedForRemoval() const
 	return mIsMarkedForRemoval;
 }
 
-sf::FloatRect Item::getBoundingRect() const
+bool Item::isUpdateIndependent() const
 {
-	return getWorldTransform().transformRect(mSprite.getGlobalBounds());
+	return true;
 }
 
 void Item::moveableCoinUpdate(sf::Time dt)
@@ -177,11 +150,11 @@ void Item::moveableCoinUpdate(sf::Time dt)
 
 void Item::behaversUpdate(sf::Time dt)
 {
-	for (const auto& behavor : mUpdateDispatcher)
+	for (const auto& behavor : mDispatch->updates)
 	{
 		if (behavor.first != mBehavors) continue;
 
-		behavor.second(dt);
+		(this->*behavor.second)(dt);
 	}
 }
 
@@ -235,12 +208,11 @@ void Item::updateCurrent(sf::Time dt, CommandQueue& commands)
 {
 	if (isDestroyed())
 	{
-		std::cout << "Item died\n";
 		mIsMarkedForRemoval = true;
 		return;
 	}
 
-	if (mUpdater) mUpdater(dt);
+	if (mDispatch->updater) (this->*mDispatch->updater)(dt);
 
 	if ( mType != Type::Mushroom)
 		updateAnimation(dt);
@@ -248,19 +220,14 @@ void Item::updateCurrent(sf::Time dt, CommandQueue& commands)
 	Entity::updateCurrent(dt, commands);
 }
 
-void Item::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
+void Item::drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const
 {
-	target.draw(mSprite, states);
+	batch.draw(mSprite, transform);
 #ifdef Debug
-	target.draw(mFootShape, states);
+	batch.drawRectangle(mFootShape, transform);
 #endif // Debug
 }
 
-sf::FloatRect Item::getFootSensorBoundingRect() const
-{
-	return getWorldTransform().transformRect(mFootShape.getGlobalBounds());
-}
-
 void Item::setFootSenseCount(unsigned int count)
 {
 	mFootSenseCount = count;
@@ -273,34 +240,7 @@ unsigned int Item::getFootSenseCount() const
 
 void Item::resolve(const sf::Vector3f& manifold, SceneNode* other)
 {
-	if (mCollision) mCollision(manifold, other);
-}
-
-void Item::collisions(const sf::Vector3f& manifold, SceneNode* other)
-{
-	for (const auto& collider : mBehaversCollision)
-	{
-		if (collider.first & other->getCategory())
-		{
-			collider.second(manifold, other);
-		}
-	}
-}
-
-void Item::resolveMushroom(const sf::Vector3f& manifold, SceneNode* other)
-{
-	for (const auto& behavor : mCollisionDispatcher)
-	{
-		if (behavor.first != mBehavors) continue;
-
-		for (const auto& collider : behavor.second)
-		{
-			if (collider.first & other->getCategory())
-			{
-				collider.second(manifold, other);
-			}
-		}
-	}
+	mDispatch->collisions.resolve(*this, mBehavors, manifold, other);
 }
 
 void Item::playerCollision(const sf::Vector3f& manifold, SceneNode* other)
@@ -3,8 +3,9 @@
 
 #include "Entity.hpp"
 #include "ResourceIdentifiers.hpp"
+#include "AtlasSprite.hpp"
+#include "CollisionTable.hpp"
 
-#include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 
 
@@ -27,35 +28,43 @@ private:
 	{
 		None,
 		Air,
-		Ground
+		Ground,
+		BehavorCount
 	};
 
 
-	using DispatchHolder = std::vector<std::pair<Behavors, Dispatcher>>;
-	using FunctionUpdater = std::function<void(sf::Time)>;
-	using UpdateHolder = std::vector<std::pair<Behavors, FunctionUpdater>>;
+	using UpdateHandler = void (Item::*)(sf::Time);
+	using Collisions = CollisionTable<Item, BehavorCount>;
+
+	// handlers of one type, built once and shared by all its instances
+	struct DispatchTable
+	{
+		UpdateHandler updater;
+		std::vector<std::pair<Behavors, UpdateHandler>> updates;
+		Collisions collisions;
+	};
 
 
 public:
-	explicit Item(Type type, const TextureHolder& textures);
+	explicit Item(Type type, const TextureHolder& textures, EntityStore& store);
+
+	// fresh state for an instance recycled by its ObjectPool
+	void reset(Type type);
 
 
 private:
-	void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const override;
+	void drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const override;
 	void updateCurrent(sf::Time dt, CommandQueue& commands) override;
 
-	sf::FloatRect getBoundingRect() const override;
 	bool isMarkedForRemoval() const override;
+	bool isUpdateIndependent() const override;
 	unsigned int getCategory() const override;
 
-	sf::FloatRect getFootSensorBoundingRect() const override;
 
 	void setFootSenseCount(unsigned int count) override;
 	unsigned int getFootSenseCount() const override;
 
 	void resolve(const sf::Vector3f& manifold, SceneNode* otherType) override;
-	void collisions(const sf::Vector3f& manifold, SceneNode* other);
-	void resolveMushroom(const sf::Vector3f& manifold, SceneNode* other);
 
 	void updateAnimation(sf::Time dt);
 
@@ -78,23 +87,24 @@ private:
 
 	void starObjectsCollision(const sf::Vector3f& manifold, SceneNode* other);
 
+	void setUp();
+	void updateColliders();
+
+	static const DispatchTable& getDispatchTable(Type type);
+
 
 private:
 	static const sf::Vector2f Gravity;
 
 	Type mType;
 	Behavors mBehavors;
-	sf::Sprite mSprite;
+	AtlasSprite mSprite;
 	sf::RectangleShape mFootShape;
 	unsigned int mFootSenseCount;
 	bool mIsMarkedForRemoval;
 
 	sf::Time mElapsedTime;
 
-	DispatchHolder mCollisionDispatcher;
-	Function mCollision;
-	Dispatcher mBehaversCollision;
-	UpdateHolder mUpdateDispatcher;
-	FunctionUpdater mUpdater;
+	const DispatchTable* mDispatch;
 };
 
@@ -0,0 +1,112 @@
+#include "LevelStreamer.hpp"
+#include "Entity.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+
+LevelStreamer::LevelStreamer(float spawnMargin, float despawnMargin)
+	: mSpawnMargin(spawnMargin)
+	, mDespawnMargin(despawnMargin)
+	, mSpawner()
+	, mDespawner()
+	, mDescriptors()
+	, mStates()
+	, mOrder()
+	, mLive()
+	, mNeedsSort(false)
+{
+	assert(despawnMargin > spawnMargin);
+}
+
+void LevelStreamer::reset(Spawner spawner, Despawner despawner)
+{
+	mSpawner = std::move(spawner);
+	mDespawner = std::move(despawner);
+
+	mDescriptors.clear();
+	mStates.clear();
+	mOrder.clear();
+	mLive.clear();
+	mNeedsSort = false;
+}
+
+void LevelStreamer::add(const Descriptor& descriptor)
+{
+	mOrder.emplace_back(descriptor.position.x, mDescriptors.size());
+	mDescriptors.emplace_back(descriptor);
+	mStates.emplace_back(Dormant);
+	mNeedsSort = true;
+}
+
+void LevelStreamer::update(const sf::FloatRect& viewBounds)
+{
+	if (mNeedsSort)
+	{
+		std::sort(mOrder.begin(), mOrder.end());
+		mNeedsSort = false;
+	}
+
+	const auto left = viewBounds.left - mDespawnMargin;
+	const auto right = viewBounds.left + viewBounds.width + mDespawnMargin;
+
+	// live entities first, so a despawned one can't come back in the same pass
+	auto live = mLive.begin();
+	for (auto& entry : mLive)
+	{
+		auto& descriptor = mDescriptors[entry.id];
+
+		if (entry.entity->isDestroyed() || entry.entity->isDying())
+		{
+			mStates[entry.id] = Consumed;
+			continue;
+		}
+
+		const auto x = entry.entity->getPosition().x;
+		if (x < left || x > right)
+		{
+			const auto from = descriptor.position.x;
+
+			mDespawner(*entry.entity, descriptor);
+			mStates[entry.id] = Dormant;
+
+			if (descriptor.position.x != from)
+				move(entry.id, from);
+
+			continue;
+		}
+
+		*live++ = entry;
+	}
+	mLive.erase(live, mLive.end());
+
+	// dormant descriptors inside the spawn margin
+	const auto spawnLeft = viewBounds.left - mSpawnMargin;
+	const auto spawnRight = viewBounds.left + viewBounds.width + mSpawnMargin;
+
+	auto first = std::lower_bound(mOrder.begin(), mOrder.end(), std::make_pair(spawnLeft, std::size_t(0u)));
+	for (auto it = first; it != mOrder.end() && it->first <= spawnRight; ++it)
+	{
+		const auto id = it->second;
+		if (mStates[id] != Dormant) continue;
+
+		mLive.push_back({ id, &mSpawner(mDescriptors[id]) });
+		mStates[id] = Active;
+	}
+}
+
+std::size_t LevelStreamer::getActiveCount() const
+{
+	return mLive.size();
+}
+
+void LevelStreamer::move(std::size_t id, float from)
+{
+	// keep the order sorted, only this entry changed its key
+	auto entry = std::lower_bound(mOrder.begin(), mOrder.end(), std::make_pair(from, id));
+	assert(entry != mOrder.end() && entry->second == id);
+	mOrder.erase(entry);
+
+	const auto key = std::make_pair(mDescriptors[id].position.x, id);
+	mOrder.insert(std::upper_bound(mOrder.begin(), mOrder.end(), key), key);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+#include <functional>
+#include <vector>
+
+
+class Entity;
+
+
+// Keeps the objects of a level as descriptors sorted by X and only spawns the
+// ones near the view, so the live entity count follows the screen size rather
+// than the level length. Entities scrolling far off the view are despawned back
+// into their descriptor, entities killed or destroyed by play never come back.
+class LevelStreamer final : private sf::NonCopyable
+{
+public:
+	// kind and type are up to the spawner
+	struct Descriptor
+	{
+		unsigned int kind;
+		unsigned int type;
+		sf::Vector2f position;
+		unsigned int count;
+	};
+
+	// creates the entity, it stays alive until destroyed or handed to the despawner
+	using Spawner = std::function<Entity&(const Descriptor&)>;
+	// writes whatever state should survive into the descriptor and removes the entity
+	using Despawner = std::function<void(Entity&, Descriptor&)>;
+
+
+private:
+	enum State
+	{
+		Dormant,
+		Active,
+		Consumed
+	};
+
+	struct Live
+	{
+		std::size_t id;
+		Entity* entity;
+	};
+
+
+public:
+	// despawnMargin should exceed spawnMargin, or entities at the edge would flicker
+	LevelStreamer(float spawnMargin = 48.f, float despawnMargin = 160.f);
+
+	void reset(Spawner spawner, Despawner despawner);
+	void add(const Descriptor& descriptor);
+
+	// call after commands are dispatched and before wrecks are removed,
+	// destroyed entities have to be seen before they are gone
+	void update(const sf::FloatRect& viewBounds);
+
+	std::size_t getActiveCount() const;
+
+
+private:
+	void move(std::size_t id, float from);
+
+
+private:
+	float mSpawnMargin;
+	float mDespawnMargin;
+	Spawner mSpawner;
+	Despawner mDespawner;
+	std::vector<Descriptor> mDescriptors;
+	std::vector<State> mStates;
+	std::vector<std::pair<float, std::size_t>> mOrder; // x, descriptor id
+	std::vector<Live> mLive;
+	bool mNeedsSort;
+};
@@ -1,17 +1,98 @@
 #include "Game.hpp"
+#include "HeadlessRunner.hpp"
+#include "Benchmark.hpp"
+#include "MapData.hpp"
+#include "Profiler.hpp"
 
 #include <stdexcept>
 #include <iostream>
+#include <string>
+#include <vector>
 
 
-int main()
+int main(int argc, char* argv[])
 {
-	try
+	std::string title = "Mario";
+	auto width = 1024u - 224u;
+	auto height = 512u;
+
+	// Mario --headless <map.tmx> <ticks> [input script] [trace.json]
+	if (argc >= 4 && std::string(argv[1]) == "--headless")
+	{
+		try
+		{
+			HeadlessRunner runner(argv[2], { static_cast<float>(width), static_cast<float>(height) }, (argc > 4) ? argv[4] : "");
+
+			runner.run(std::stoul(argv[3]));
+
+			if (argc > 5 && !Profiler::instance().exportTrace(argv[5]))
+				throw std::runtime_error(std::string("can't write trace ") + argv[5]);
+		}
+		catch (std::exception& e)
+		{
+			std::cout << "Exception: " << e.what() << std::endl;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	// Mario --benchmark [goombas] [troopas] [ticks]
+	if (argc >= 2 && std::string(argv[1]) == "--benchmark")
+	{
+		try
+		{
+			Benchmark benchmark((argc > 2) ? std::stoul(argv[2]) : 100u,
+				(argc > 3) ? std::stoul(argv[3]) : 100u,
+				(argc > 4) ? std::stoul(argv[4]) : 600u);
+
+			benchmark.run({
+				"Media/Maps/test000.tmx", "Media/Maps/test001.tmx", "Media/Maps/test002.tmx",
+				"Media/Maps/test003.tmx", "Media/Maps/test004.tmx", "Media/Maps/test005.tmx",
+				"Media/Maps/test006.tmx", "Media/Maps/test007.tmx", "Media/Maps/junk00.tmx",
+			});
+		}
+		catch (std::exception& e)
+		{
+			std::cout << "Exception: " << e.what() << std::endl;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	// Mario --convert-maps [map.tmx...], writes a precompiled .lvl next to each map
+	if (argc >= 2 && std::string(argv[1]) == "--convert-maps")
 	{
-		std::string title = "Mario";
-		auto width = 1024u - 224u;
-		auto height = 512u;
+		std::vector<std::string> maps(argv + 2, argv + argc);
+
+		if (maps.empty())
+		{
+			maps = {
+				"Media/Maps/test00.tmx", "Media/Maps/test000.tmx", "Media/Maps/test001.tmx",
+				"Media/Maps/test002.tmx", "Media/Maps/test003.tmx", "Media/Maps/test004.tmx",
+				"Media/Maps/test005.tmx", "Media/Maps/test006.tmx", "Media/Maps/test007.tmx",
+				"Media/Maps/junk00.tmx",
+			};
+		}
+
+		auto failed = 0;
+		for (const auto& map : maps)
+		{
+			auto target = map.substr(0, map.find_last_of('.')) + ".lvl";
 
+			MapData data;
+			if (data.loadFromTmx(map) && data.saveToFile(target))
+				std::cout << map << " -> " << target << "\n";
+			else
+				failed++;
+		}
+
+		return failed == 0 ? 0 : 1;
+	}
+
+	try
+	{
 		Game game(title, width, height);
 
 		game.run();
@@ -22,4 +103,4 @@ int main()
 		std::cin.ignore();
 		return 1;
 	}
-}
\ No newline at end of file
+}
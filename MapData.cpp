@@ -0,0 +1,261 @@
+#include "MapData.hpp"
+#include "Compression.hpp"
+#include "pugixml/pugixml.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <fstream>
+
+
+namespace
+{
+	// exactly count gids separated by commas, whitespace around them is skipped
+	bool decodeCsv(const char* text, std::uint32_t* tiles, std::size_t count)
+	{
+		auto isSpace = [](char c)
+		{
+			return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+		};
+
+		auto index = std::size_t(0u);
+
+		while (true)
+		{
+			while (isSpace(*text)) ++text;
+
+			if (*text < '0' || *text > '9' || index == count)
+				return false;
+
+			auto value = std::uint64_t(0u);
+			for (; *text >= '0' && *text <= '9'; ++text)
+			{
+				value = value * 10u + static_cast<std::uint64_t>(*text - '0');
+				if (value > 0xffffffffu) return false;
+			}
+
+			tiles[index++] = static_cast<std::uint32_t>(value);
+
+			while (isSpace(*text)) ++text;
+
+			if (*text != ',')
+				return *text == '\0' && index == count;
+
+			++text;
+		}
+	}
+
+	// little endian gids, optionally zlib or gzip compressed, whitespace is skipped
+	bool decodeBase64(const char* text, const std::string& compression, std::uint32_t* tiles, std::size_t count)
+	{
+		static const auto Table = []
+		{
+			std::array<signed char, 256> table;
+			table.fill(-1);
+
+			const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			for (auto i = 0u; i < alphabet.size(); ++i)
+				table[static_cast<unsigned char>(alphabet[i])] = static_cast<signed char>(i);
+
+			return table;
+		}();
+
+		std::vector<unsigned char> bytes;
+		auto buffer = 0u;
+		auto bits = 0u;
+
+		for (; *text && *text != '='; ++text)
+		{
+			auto sextet = Table[static_cast<unsigned char>(*text)];
+
+			if (sextet < 0)
+				continue;
+
+			buffer = (buffer << 6) | static_cast<unsigned int>(sextet);
+			bits += 6u;
+
+			if (bits >= 8u)
+			{
+				bits -= 8u;
+				bytes.push_back(static_cast<unsigned char>(buffer >> bits));
+				buffer &= (1u << bits) - 1u;
+			}
+		}
+
+		if (compression == "zlib" || compression == "gzip")
+		{
+			std::vector<unsigned char> inflated;
+			if (!compression::inflate(bytes, inflated))
+				return false;
+
+			bytes.swap(inflated);
+		}
+		else if (!compression.empty())
+			return false;
+
+		if (bytes.size() < count * 4u)
+			return false;
+
+		for (auto i = std::size_t(0u); i < count; ++i)
+		{
+			const auto* gid = &bytes[i * 4u];
+			tiles[i] = gid[0] | (gid[1] << 8) | (gid[2] << 16) | (static_cast<std::uint32_t>(gid[3]) << 24);
+		}
+
+		return true;
+	}
+}
+
+MapData::MapData()
+	: header()
+	, tiles()
+	, objects()
+	, strings()
+{
+}
+
+bool MapData::loadFromTmx(const std::string& filename)
+{
+	pugi::xml_document mapDoc;
+
+	if (!mapDoc.load_file(filename.c_str()))
+	{
+		std::cerr << "Loading level \"" + filename + "\" failed.\n";
+		return false;
+	}
+
+	header = MapFormat::Header();
+	tiles.clear();
+	objects.clear();
+	strings.clear();
+
+	auto mapNode = mapDoc.child("map");
+
+	header.magic = MapFormat::Magic;
+	header.version = MapFormat::Version;
+	header.width = mapNode.attribute("width").as_uint();
+	header.height = mapNode.attribute("height").as_uint();
+	header.tileWidth = mapNode.attribute("tilewidth").as_uint();
+	header.tileHeight = mapNode.attribute("tileheight").as_uint();
+
+	auto tilesetNode = mapNode.child("tileset");
+
+	header.firstTileID = tilesetNode.attribute("firstgid").as_uint();
+
+	auto image = tilesetNode.child("image");
+
+	std::string imagePath = image.attribute("source").as_string();
+
+	auto x = imagePath.find_first_of("./");
+	auto split = imagePath.substr(++x, imagePath.size());
+
+	header.tileset = intern("Media" + split);
+
+	const auto cells = header.width * header.height;
+
+	for (auto layerNode = mapNode.child("layer"); layerNode; layerNode = layerNode.next_sibling("layer"))
+	{
+		tiles.resize(tiles.size() + cells, 0u);
+
+		auto* layer = &tiles[tiles.size() - cells];
+		auto dataNode = layerNode.child("data");
+
+		std::string encoding = dataNode.attribute("encoding").as_string();
+		std::string compression = dataNode.attribute("compression").as_string();
+
+		auto decoded = true;
+
+		if (encoding.empty())
+		{
+			auto tileNode = dataNode.child("tile");
+
+			auto i = 0u;
+			for (; i < cells && tileNode; ++i, tileNode = tileNode.next_sibling("tile"))
+				layer[i] = tileNode.attribute("gid").as_uint();
+
+			decoded = (i == cells && !tileNode);
+		}
+		else if (encoding == "csv" && compression.empty())
+			decoded = decodeCsv(dataNode.child_value(), layer, cells);
+		else if (encoding == "base64")
+			decoded = decodeBase64(dataNode.child_value(), compression, layer, cells);
+		else
+			decoded = false;
+
+		if (!decoded)
+		{
+			std::cerr << "Level \"" + filename + "\" has unsupported or broken layer data (" + encoding + " " + compression + ").\n";
+			return false;
+		}
+
+		header.layerCount++;
+	}
+
+	for (auto node = mapNode.child("objectgroup"); node; node = node.next_sibling("objectgroup"))
+	{
+		for (auto objectNode = node.child("object"); objectNode; objectNode = objectNode.next_sibling("object"))
+		{
+			MapFormat::Object object;
+			object.name = intern(objectNode.attribute("name").as_string());
+			object.type = intern(objectNode.attribute("type").as_string());
+			object.x = objectNode.attribute("x").as_float();
+			object.y = objectNode.attribute("y").as_float();
+			object.width = objectNode.attribute("width").as_float();
+			object.height = objectNode.attribute("height").as_float();
+
+			auto propertisNode = objectNode.child("properties");
+			auto propertyNode = propertisNode.child("property");
+			object.count = propertyNode.attribute("value").as_uint();
+
+			objects.push_back(object);
+		}
+	}
+
+	header.objectCount = static_cast<std::uint32_t>(objects.size());
+	header.stringCount = static_cast<std::uint32_t>(strings.size());
+	header.stringBytes = 0u;
+	for (const auto& string : strings)
+		header.stringBytes += static_cast<std::uint32_t>(string.size());
+
+	return true;
+}
+
+bool MapData::saveToFile(const std::string& filename) const
+{
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+
+	if (!file)
+	{
+		std::cerr << "can't write level: " + filename + "\n";
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(tiles.data()), tiles.size() * sizeof(std::uint32_t));
+	file.write(reinterpret_cast<const char*>(objects.data()), objects.size() * sizeof(MapFormat::Object));
+
+	MapFormat::String entry = { 0u, 0u };
+	for (const auto& string : strings)
+	{
+		entry.length = static_cast<std::uint32_t>(string.size());
+		file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+		entry.offset += entry.length;
+	}
+
+	for (const auto& string : strings)
+		file.write(string.data(), string.size());
+
+	return static_cast<bool>(file);
+}
+
+std::uint32_t MapData::intern(const std::string& string)
+{
+	auto found = std::find(strings.cbegin(), strings.cend(), string);
+
+	if (found != strings.cend())
+		return static_cast<std::uint32_t>(found - strings.cbegin());
+
+	strings.push_back(string);
+
+	return static_cast<std::uint32_t>(strings.size() - 1u);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+
+#include "MapFormat.hpp"
+
+#include <string>
+#include <vector>
+
+
+// Level contents in the precompiled layout, read from a Tiled .tmx file
+struct MapData
+{
+	MapData();
+
+	bool loadFromTmx(const std::string& filename);
+	bool saveToFile(const std::string& filename) const;
+
+	// returns the id of string, adding it on first use
+	std::uint32_t intern(const std::string& string);
+
+	MapFormat::Header					header;
+	std::vector<std::uint32_t>			tiles;
+	std::vector<MapFormat::Object>		objects;
+	std::vector<std::string>			strings;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+
+#include <cstdint>
+
+
+// Precompiled level layout (.lvl), native byte order:
+//   Header
+//   std::uint32_t tiles[layerCount * height * width]	row major, one block per layer
+//   Object objects[objectCount]
+//   String strings[stringCount]
+//   char characters[stringBytes]
+namespace MapFormat
+{
+	const std::uint32_t Magic = 0x4c564c4d; // "MLVL"
+	const std::uint32_t Version = 1u;
+
+	struct Header
+	{
+		std::uint32_t	magic;
+		std::uint32_t	version;
+		std::uint32_t	width;
+		std::uint32_t	height;
+		std::uint32_t	tileWidth;
+		std::uint32_t	tileHeight;
+		std::uint32_t	firstTileID;
+		std::uint32_t	tileset;		// string id of the tileset image path
+		std::uint32_t	layerCount;
+		std::uint32_t	objectCount;
+		std::uint32_t	stringCount;
+		std::uint32_t	stringBytes;
+	};
+
+	struct Object
+	{
+		std::uint32_t	name;			// string id
+		std::uint32_t	type;			// string id
+		float			x;
+		float			y;
+		float			width;
+		float			height;
+		std::uint32_t	count;
+	};
+
+	struct String
+	{
+		std::uint32_t	offset;
+		std::uint32_t	length;
+	};
+}
@@ -0,0 +1,141 @@
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+	: mFile(INVALID_HANDLE_VALUE)
+	, mMapping(nullptr)
+	, mData(nullptr)
+	, mSize(0u)
+{
+}
+
+bool MappedFile::open(const std::string& filename)
+{
+	close();
+
+	mFile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (mFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0)
+	{
+		close();
+		return false;
+	}
+
+	mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mMapping)
+	{
+		close();
+		return false;
+	}
+
+	mData = static_cast<const char*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+	if (!mData)
+	{
+		close();
+		return false;
+	}
+
+	mSize = static_cast<std::size_t>(size.QuadPart);
+
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (mData)
+		UnmapViewOfFile(mData);
+
+	if (mMapping)
+		CloseHandle(mMapping);
+
+	if (mFile != INVALID_HANDLE_VALUE)
+		CloseHandle(mFile);
+
+	mFile = INVALID_HANDLE_VALUE;
+	mMapping = nullptr;
+	mData = nullptr;
+	mSize = 0u;
+}
+
+#else
+
+MappedFile::MappedFile()
+	: mFile(-1)
+	, mData(nullptr)
+	, mSize(0u)
+{
+}
+
+bool MappedFile::open(const std::string& filename)
+{
+	close();
+
+	mFile = ::open(filename.c_str(), O_RDONLY);
+	if (mFile < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(mFile, &info) != 0 || info.st_size == 0)
+	{
+		close();
+		return false;
+	}
+
+	auto* data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, mFile, 0);
+	if (data == MAP_FAILED)
+	{
+		close();
+		return false;
+	}
+
+	mData = static_cast<const char*>(data);
+	mSize = static_cast<std::size_t>(info.st_size);
+
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (mData)
+		munmap(const_cast<char*>(mData), mSize);
+
+	if (mFile >= 0)
+		::close(mFile);
+
+	mFile = -1;
+	mData = nullptr;
+	mSize = 0u;
+}
+
+#endif // _WIN32
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+const char* MappedFile::getData() const
+{
+	return mData;
+}
+
+std::size_t MappedFile::getSize() const
+{
+	return mSize;
+}
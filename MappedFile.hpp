@@ -0,0 +1,32 @@
+#pragma once
+
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <string>
+
+
+// Read only memory mapping of a whole file
+class MappedFile final : private sf::NonCopyable
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	bool open(const std::string& filename);
+	void close();
+
+	const char* getData() const;
+	std::size_t getSize() const;
+
+
+private:
+#ifdef _WIN32
+	void* mFile;
+	void* mMapping;
+#else
+	int mFile;
+#endif
+	const char* mData;
+	std::size_t mSize;
+};
@@ -0,0 +1,44 @@
+#include "ObjectPool.hpp"
+
+#include <cassert>
+
+
+NodePool::NodePool(std::size_t capacity)
+	: mFree()
+	, mAllocations(0u)
+{
+	mFree.reserve(capacity);
+}
+
+void NodePool::recycle(SceneNode::Ptr node)
+{
+	assert(node->mPool == this);
+
+	mFree.emplace_back(std::move(node));
+}
+
+std::size_t NodePool::getFreeCount() const
+{
+	return mFree.size();
+}
+
+std::size_t NodePool::getAllocationCount() const
+{
+	return mAllocations;
+}
+
+SceneNode::Ptr NodePool::take()
+{
+	if (mFree.empty())
+		return nullptr;
+
+	auto node = std::move(mFree.back());
+	mFree.pop_back();
+	return node;
+}
+
+void NodePool::adopt(SceneNode& node)
+{
+	node.mPool = this;
+	++mAllocations;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+
+#include "SceneNode.hpp"
+#include "ResourceIdentifiers.hpp"
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <memory>
+#include <vector>
+
+
+class EntityStore;
+
+
+// Free list of retired scene nodes. SceneNode::removeWrecks hands pooled
+// wrecks back here instead of deleting them.
+class NodePool : private sf::NonCopyable
+{
+public:
+	explicit NodePool(std::size_t capacity);
+
+	void recycle(SceneNode::Ptr node);
+
+	std::size_t getFreeCount() const;
+	// instances created since the pool was made, flat once spawning is steady
+	std::size_t getAllocationCount() const;
+
+
+protected:
+	~NodePool() = default;
+
+	SceneNode::Ptr take();
+	void adopt(SceneNode& node);
+
+
+private:
+	std::vector<SceneNode::Ptr> mFree;
+	std::size_t mAllocations;
+};
+
+
+// Pool of one entity class, T is built from (T::Type, const TextureHolder&, EntityStore&)
+// and reinitialised for a new life by T::reset(T::Type).
+template <typename T>
+class ObjectPool final : public NodePool
+{
+public:
+	ObjectPool(const TextureHolder& textures, EntityStore& store, std::size_t capacity = 64u);
+
+	// a recycled instance when one is free, a new one otherwise
+	std::unique_ptr<T> acquire(typename T::Type type);
+
+
+private:
+	const TextureHolder& mTextures;
+	EntityStore& mStore;
+};
+
+#include "ObjectPool.inl"
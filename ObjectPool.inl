@@ -0,0 +1,24 @@
+template <typename T>
+ObjectPool<T>::ObjectPool(const TextureHolder& textures, EntityStore& store, std::size_t capacity)
+	: NodePool(capacity)
+	, mTextures(textures)
+	, mStore(store)
+{
+}
+
+template <typename T>
+std::unique_ptr<T> ObjectPool<T>::acquire(typename T::Type type)
+{
+	auto node = take();
+
+	if (!node)
+	{
+		auto object(std::make_unique<T>(type, mTextures, mStore));
+		adopt(*object);
+		return object;
+	}
+
+	std::unique_ptr<T> object(static_cast<T*>(node.release()));
+	object->reset(type);
+	return object;
+}
@@ -0,0 +1,104 @@
+#include "ParallelUpdater.hpp"
+#include "ThreadPool.hpp"
+
+
+ParallelUpdater::ParallelUpdater(ThreadPool& workers)
+	: mWorkers(workers)
+	, mLanes()
+	, mRanges()
+	, mIndependent()
+	, mChildren(nullptr)
+	, mRangeBase(0u)
+	, mFirst(0u)
+	, mCount(0u)
+	, mDelta()
+	, mNext(0u)
+{
+	// the calling thread helps in ThreadPool::wait, so it needs a lane too
+	for (auto i = std::size_t(0u); i < workers.getWorkerCount() + 1u; ++i)
+		mLanes.emplace_back(std::make_unique<Lane>());
+}
+
+void ParallelUpdater::update(SceneNode& node, sf::Time dt, CommandQueue& commands)
+{
+	updateNode(node, dt, commands);
+
+	for (auto& lane : mLanes)
+		lane->commands.clear();
+}
+
+void ParallelUpdater::updateNode(SceneNode& node, sf::Time dt, CommandQueue& commands)
+{
+	node.updateCurrent(dt, commands);
+
+	auto& children = node.mChildren;
+
+	const auto base = mRanges.size();
+	const auto first = mIndependent.size();
+
+	mRanges.resize(base + children.size());
+	for (auto i = std::size_t(0u); i < children.size(); ++i)
+	{
+		if (children[i]->isUpdateIndependent())
+			mIndependent.push_back(i);
+	}
+
+	const auto count = mIndependent.size() - first;
+	if (count > 0u)
+	{
+		// workers read the world transforms of the ancestors, compute them here once
+		node.getWorldTransform();
+
+		mChildren = &children;
+		mRangeBase = base;
+		mFirst = first;
+		mCount = count;
+		mDelta = dt;
+		mNext = 0u;
+
+		mWorkers.dispatch(mLanes.size(), [this](std::size_t lane) { runLane(lane); });
+		mWorkers.wait();
+	}
+
+	for (auto i = std::size_t(0u), next = first; i < children.size(); ++i)
+	{
+		if (next < mIndependent.size() && mIndependent[next] == i)
+		{
+			const auto& range = mRanges[base + i];
+			const auto& lane = *mLanes[range.lane];
+
+			for (auto c = range.begin; c < range.end; ++c)
+				commands.push(lane.commands[c]);
+
+			++next;
+		}
+		else
+		{
+			updateNode(*children[i], dt, commands);
+		}
+	}
+
+	mRanges.resize(base);
+	mIndependent.resize(first);
+}
+
+void ParallelUpdater::runLane(std::size_t index)
+{
+	auto& lane = *mLanes[index];
+
+	for (auto k = mNext++; k < mCount; k = mNext++)
+	{
+		const auto i = mIndependent[mFirst + k];
+
+		(*mChildren)[i]->update(mDelta, lane.queue);
+
+		const auto begin = lane.commands.size();
+		while (!lane.queue.isEmpty())
+		{
+			lane.commands.push_back(lane.queue.front());
+			lane.queue.pop();
+		}
+
+		mRanges[mRangeBase + i] = { index, begin, lane.commands.size() };
+	}
+}
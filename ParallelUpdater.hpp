@@ -0,0 +1,66 @@
+#pragma once
+
+
+#include "SceneNode.hpp"
+#include "CommandQueue.hpp"
+#include "Command.hpp"
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+
+class ThreadPool;
+
+
+// Two-phase scene update. Children that report isUpdateIndependent() are
+// first updated in parallel, one lane per thread pulling the next child off
+// a shared counter, each lane pushing into its own command buffer. Then the
+// children are walked in order: buffered commands are merged into the real
+// queue and the remaining children are updated in place. The queue ends up
+// in the same order as a serial SceneNode::update.
+class ParallelUpdater final : private sf::NonCopyable
+{
+	struct Lane
+	{
+		CommandQueue queue;
+		std::vector<Command> commands;
+	};
+
+	// commands a child pushed, commands[begin, end) of its lane
+	struct Range
+	{
+		std::size_t lane;
+		std::size_t begin;
+		std::size_t end;
+	};
+
+
+public:
+	explicit ParallelUpdater(ThreadPool& workers);
+
+	void update(SceneNode& node, sf::Time dt, CommandQueue& commands);
+
+
+private:
+	void updateNode(SceneNode& node, sf::Time dt, CommandQueue& commands);
+	void runLane(std::size_t lane);
+
+
+private:
+	ThreadPool& mWorkers;
+	std::vector<std::unique_ptr<Lane>> mLanes;
+	std::vector<Range> mRanges;				// per child, stacked by depth
+	std::vector<std::size_t> mIndependent;	// child indices, stacked by depth
+
+	// the batch in flight
+	std::vector<SceneNode::Ptr>* mChildren;
+	std::size_t mRangeBase;
+	std::size_t mFirst;
+	std::size_t mCount;
+	sf::Time mDelta;
+	std::atomic<std::size_t> mNext;
+};
@@ -0,0 +1,49 @@
+#include "Particle.hpp"
+
+
+void ParticleArray::reserve(std::size_t count)
+{
+	positionX.reserve(count);
+	positionY.reserve(count);
+	velocityX.reserve(count);
+	velocityY.reserve(count);
+	rotation.reserve(count);
+	rotationSpeed.reserve(count);
+	lifetime.reserve(count);
+	color.reserve(count);
+}
+
+std::size_t ParticleArray::size() const
+{
+	return lifetime.size();
+}
+
+void ParticleArray::push(float x, float y, float vx, float vy, float angle, float spin, float seconds, const sf::Color& tint)
+{
+	positionX.push_back(x);
+	positionY.push_back(y);
+	velocityX.push_back(vx);
+	velocityY.push_back(vy);
+	rotation.push_back(angle);
+	rotationSpeed.push_back(spin);
+	lifetime.push_back(seconds);
+	color.push_back(tint);
+}
+
+void ParticleArray::remove(std::size_t index)
+{
+	auto swapPop = [index](auto& array)
+	{
+		array[index] = array.back();
+		array.pop_back();
+	};
+
+	swapPop(positionX);
+	swapPop(positionY);
+	swapPop(velocityX);
+	swapPop(velocityY);
+	swapPop(rotation);
+	swapPop(rotationSpeed);
+	swapPop(lifetime);
+	swapPop(color);
+}
@@ -1,10 +1,10 @@
 #pragma once
 
 
-#include <SFML/System/Vector2.hpp>
-#include <SFML/System/Time.hpp>
 #include <SFML/Graphics/Color.hpp>
 
+#include <vector>
+
 
 struct Particle
 {
@@ -13,12 +13,24 @@ struct Particle
 		Splash,
 		ParticleCount
 	};
+};
+
+// particles as structure of arrays, particle i is element i of every array
+struct ParticleArray
+{
+	void reserve(std::size_t count);
+	std::size_t size() const;
 
-	sf::Vector2f position;
-	sf::Vector2f velocity;
-	float rotation;
-	float rotationSpeed;
-	sf::Color color;
-	sf::Time lifetime;
+	void push(float x, float y, float vx, float vy, float angle, float spin, float seconds, const sf::Color& tint);
+	// moves the last particle into index, order is not kept
+	void remove(std::size_t index);
 
-};
\ No newline at end of file
+	std::vector<float> positionX;
+	std::vector<float> positionY;
+	std::vector<float> velocityX;
+	std::vector<float> velocityY;
+	std::vector<float> rotation;
+	std::vector<float> rotationSpeed;
+	std::vector<float> lifetime;		// seconds left
+	std::vector<sf::Color> color;
+};
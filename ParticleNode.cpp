@@ -1,11 +1,14 @@
 #include "ParticleNode.hpp"
-#include "ResourceHolder.hpp"
+#include "TextureAtlas.hpp"
 #include "Utility.hpp"
+#include "SpriteBatch.hpp"
+#include "Profiler.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Texture.hpp>
 
-#include <iostream>
+#include <algorithm>
+#include <cmath>
 
 namespace
 {
@@ -13,13 +16,27 @@ namespace
 }
 
 
-ParticleNode::ParticleNode(Particle::Type type, const TextureHolder& textures)
+ParticleNode::ParticleNode(Particle::Type type, const TextureHolder& textures, std::size_t capacity, Overflow overflow)
 	: mParticles()
+	, mCapacity(capacity)
+	, mOverflow(overflow)
+	, mPeakCount(0u)
+	, mDroppedCount(0u)
 	, mTexture(textures.get(Textures::Particle))
+	, mTextureRect(textures.getRegion(Textures::Particle))
 	, mType(type)
-	, mVertexArray(sf::Quads)
-	, mNeedsVertexUpdate(true)
+	, mVertexBuffers()
+	, mFrontBuffer(0u)
+	, mAffectors()
 {
+	mParticles.reserve(mCapacity);
+
+	for (auto& vertices : mVertexBuffers)
+	{
+		vertices.setPrimitiveType(sf::Quads);
+		vertices.resize(mCapacity * 4);
+		vertices.clear();
+	}
 }
 
 void ParticleNode::addParticle(sf::Vector2f position)
@@ -33,15 +50,23 @@ void ParticleNode::addParticle(sf::Vector2f position)
 		{  70.f, -90.f },
 	};
 
-	Particle particle;
-	particle.position = position;
-	particle.velocity = splatVelocities[index++ % splatVelocities.size()];
-	particle.rotation = 45.f;
-	particle.rotationSpeed = 0.f;
-	particle.color = sf::Color(255, 255, 50);
-	particle.lifetime = lifetime;
+	if (mParticles.size() >= mCapacity)
+	{
+		mDroppedCount++;
+
+		if (mOverflow == RejectNew || mCapacity == 0u)
+			return;
 
-	mParticles.emplace_back(particle);
+		// all particles start with the same lifetime, the least left is the oldest
+		auto oldest = std::min_element(mParticles.lifetime.cbegin(), mParticles.lifetime.cend());
+		mParticles.remove(static_cast<std::size_t>(oldest - mParticles.lifetime.cbegin()));
+	}
+
+	const auto& velocity = splatVelocities[index++ % splatVelocities.size()];
+
+	mParticles.push(position.x, position.y, velocity.x, velocity.y, 45.f, 0.f, lifetime.asSeconds(), sf::Color(255, 255, 50));
+
+	mPeakCount = std::max(mPeakCount, mParticles.size());
 }
 
 Particle::Type ParticleNode::getParticleType() const
@@ -60,70 +85,134 @@ void ParticleNode::emit(sf::Vector2f position)
 		addParticle(position);
 }
 
-void ParticleNode::updateCurrent(sf::Time dt, CommandQueue& commands)
+std::size_t ParticleNode::getCapacity() const
 {
-	if (mParticles.empty()) return;
-
-	while (!mParticles.empty() && mParticles.front().lifetime <= sf::Time::Zero)
-		mParticles.pop_front();
+	return mCapacity;
+}
 
-	for (auto& particle : mParticles)
-	{
-		particle.lifetime -= dt;
-		particle.position += dt.asSeconds() * particle.velocity;
-		particle.rotation += dt.asSeconds() * particle.rotationSpeed;
+std::size_t ParticleNode::getLiveCount() const
+{
+	return mParticles.size();
+}
 
-		for (const auto& affector : mAffectors)
-			affector(particle, dt);
-	}
+std::size_t ParticleNode::getPeakCount() const
+{
+	return mPeakCount;
+}
 
-	mNeedsVertexUpdate = true;
+std::size_t ParticleNode::getDroppedCount() const
+{
+	return mDroppedCount;
 }
 
-void ParticleNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
+void ParticleNode::simulate(sf::Time dt)
 {
-	if (mParticles.empty()) return;
+	PROFILE_SCOPE("Particle simulate");
 
-	if (mNeedsVertexUpdate)
+	auto& vertices = mVertexBuffers[1u - mFrontBuffer];
+
+	if (mParticles.lifetime.empty())
 	{
-		computeVertices();
-		mNeedsVertexUpdate = false;
+		vertices.clear();
+		return;
 	}
 
-	states.texture = &mTexture;
+	const auto count = mParticles.lifetime.size();
+	const auto seconds = dt.asSeconds();
+
+	auto* positionX = mParticles.positionX.data();
+	auto* positionY = mParticles.positionY.data();
+	auto* rotation = mParticles.rotation.data();
+	auto* lifetimes = mParticles.lifetime.data();
+	const auto* velocityX = mParticles.velocityX.data();
+	const auto* velocityY = mParticles.velocityY.data();
+	const auto* rotationSpeed = mParticles.rotationSpeed.data();
 
-	target.draw(mVertexArray, states);
+	// one plain loop per array so the compiler can vectorize them
+	for (auto i = std::size_t(0u); i < count; ++i)
+		lifetimes[i] -= seconds;
+
+	for (auto i = std::size_t(0u); i < count; ++i)
+		positionX[i] += seconds * velocityX[i];
+
+	for (auto i = std::size_t(0u); i < count; ++i)
+		positionY[i] += seconds * velocityY[i];
+
+	for (auto i = std::size_t(0u); i < count; ++i)
+		rotation[i] += seconds * rotationSpeed[i];
+
+	removeExpired();
+
+	for (const auto& affector : mAffectors)
+		affector(mParticles, dt);
+
+	computeVertices(vertices);
 }
 
-void ParticleNode::addVertex(sf::Vector2f position, sf::Vector2f texCoord, const sf::Color& color) const
+void ParticleNode::swapBuffers()
 {
-	sf::Vertex vertex;
-	vertex.position = position;
-	vertex.texCoords = texCoord;
-	vertex.color = color;
+	mFrontBuffer = 1u - mFrontBuffer;
+}
+
+void ParticleNode::drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const
+{
+	batch.draw(mVertexBuffers[mFrontBuffer], mTexture, transform);
+}
 
-	mVertexArray.append(vertex);
+void ParticleNode::removeExpired()
+{
+	for (auto i = std::size_t(0u); i < mParticles.size();)
+	{
+		if (mParticles.lifetime[i] <= 0.f)
+			mParticles.remove(i);
+		else
+			++i;
+	}
 }
 
-void ParticleNode::computeVertices() const
+void ParticleNode::computeVertices(sf::VertexArray& vertices) const
 {
-	const static sf::Vector2f size(mTexture.getSize());
-	const static sf::Vector2f half = size / 2.f;
+	const sf::Vector2f size(static_cast<float>(mTextureRect.width), static_cast<float>(mTextureRect.height));
+	const sf::Vector2f half = size / 2.f;
+	const sf::Vector2f corner(static_cast<float>(mTextureRect.left), static_cast<float>(mTextureRect.top));
+	const auto count = mParticles.lifetime.size();
+
+	// storage was reserved for the whole pool, resizing never reallocates
+	vertices.resize(count * 4);
+
+	if (count == 0u)
+		return;
 
-	mVertexArray.clear();
-	for (const auto& particle : mParticles)
+	auto* quad = &vertices[0];
+	for (auto i = std::size_t(0u); i < count; ++i, quad += 4)
 	{
-		sf::Transform transform;
-		transform.translate(particle.position);
-		transform.rotate(particle.rotation);
-		auto color = particle.color;
+		const auto angle = mParticles.rotation[i] * static_cast<float>(M_PI) / 180.f;
+		const auto cos = std::cos(angle);
+		const auto sin = std::sin(angle);
 
-		auto ratio = particle.lifetime.asSeconds() / lifetime.asSeconds();
+		// rotated corner offsets, same as translate(position) * rotate(rotation)
+		const auto ax = cos * half.x - sin * half.y;
+		const auto ay = sin * half.x + cos * half.y;
+		const auto bx = cos * half.x + sin * half.y;
+		const auto by = sin * half.x - cos * half.y;
+
+		const sf::Vector2f position(mParticles.positionX[i], mParticles.positionY[i]);
+
+		auto color = mParticles.color[i];
+		auto ratio = mParticles.lifetime[i] / lifetime.asSeconds();
 		color.a = static_cast<sf::Uint8>(255 * std::max(ratio, 0.f));
 
-		addVertex(transform.transformPoint(-half.x, -half.y), { 0.f,	0.f	   }, color);
-		addVertex(transform.transformPoint( half.x, -half.y), { size.x,	0.f    }, color);
-		addVertex(transform.transformPoint( half.x,  half.y), { size.x,	size.y }, color);
-		addVertex(transform.transformPoint(-half.x,  half.y), { 0.f,	size.y }, color);
+		quad[0].position = { position.x - ax, position.y - ay };
+		quad[1].position = { position.x + bx, position.y + by };
+		quad[2].position = { position.x + ax, position.y + ay };
+		quad[3].position = { position.x - bx, position.y - by };
+
+		quad[0].texCoords = corner;
+		quad[1].texCoords = corner + sf::Vector2f(size.x, 0.f);
+		quad[2].texCoords = corner + size;
+		quad[3].texCoords = corner + sf::Vector2f(0.f, size.y);
+
+		for (auto v = 0; v < 4; ++v)
+			quad[v].color = color;
 	}
-}
\ No newline at end of file
+}
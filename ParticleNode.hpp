@@ -7,18 +7,27 @@
 
 #include <SFML/Graphics/VertexArray.hpp>
 
-#include <deque>
+#include <array>
 #include <functional>
 #include <vector>
 
 
 class ParticleNode final : public SceneNode
 {
-	using Affector = std::function<void(Particle&, sf::Time)>;
+	using Affector = std::function<void(ParticleArray&, sf::Time)>;
 
 
 public:
-	explicit ParticleNode(Particle::Type type, const TextureHolder& textures);
+	// what addParticle does when the pool is full
+	enum Overflow
+	{
+		DropOldest,
+		RejectNew,
+	};
+
+
+public:
+	explicit ParticleNode(Particle::Type type, const TextureHolder& textures, std::size_t capacity = 1024u, Overflow overflow = DropOldest);
 
 	void addParticle(sf::Vector2f position);
 
@@ -28,28 +37,42 @@ public:
 	template <typename T>
 	void addAffector(const T& affector)
 	{
-		using namespace std::placeholders;
-		mAffectors.emplace_back(std::bind(affector, _1, _2));
+		mAffectors.emplace_back(affector);
 	}
 
 	void emit(sf::Vector2f position);
 
+	std::size_t getCapacity() const;
+	std::size_t getLiveCount() const;
+	std::size_t getPeakCount() const;
+	std::size_t getDroppedCount() const;
+
+	// advances the particles and fills the back vertex buffer, may run on a worker
+	// thread while the front buffer is drawn, nothing else may touch the node meanwhile
+	void simulate(sf::Time dt);
+	// shows the last simulated vertices, call when no simulate is in flight
+	void swapBuffers();
+
 
 private:
-	void updateCurrent(sf::Time dt, CommandQueue& commands) override;
-	void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const override;
+	void drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const override;
 
-	void addVertex(sf::Vector2f position, sf::Vector2f texCoord, const sf::Color& color) const;
-	void computeVertices() const;
+	void removeExpired();
+	void computeVertices(sf::VertexArray& vertices) const;
 
 
 private:
-	std::deque<Particle> mParticles;
-	const sf::Texture& mTexture;
+	ParticleArray mParticles;
+	std::size_t mCapacity;
+	Overflow mOverflow;
+	std::size_t mPeakCount;
+	std::size_t mDroppedCount;
+	const sf::Texture* mTexture;
+	sf::IntRect mTextureRect;
 	Particle::Type mType;
 
-	mutable sf::VertexArray	mVertexArray;
-	mutable bool mNeedsVertexUpdate;
+	std::array<sf::VertexArray, 2> mVertexBuffers;
+	std::size_t mFrontBuffer;
 
 	std::vector<Affector> mAffectors;
 };
\ No newline at end of file
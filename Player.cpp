@@ -1,8 +1,9 @@
 #include "Player.hpp"
 #include "DataTables.hpp"
-#include "ResourceHolder.hpp"
+#include "TextureAtlas.hpp"
 #include "CommandQueue.hpp"
 #include "Utility.hpp"
+#include "SpriteBatch.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <algorithm>
@@ -17,10 +18,11 @@ namespace
 	const static std::vector<PlayerData>& Table = data::initializePlayerData();
 }
 
-Player::Player(Type type, const TextureHolder& textures)
-	: mType(type)
+Player::Player(Type type, const TextureHolder& textures, EntityStore& store, ObjectPool<Projectile>& projectiles)
+	: Entity(store)
+	, mType(type)
 	, mBehavors(Air)
-	, mSprite(textures.get(Table[type].texture), Table[type].idleRect)
+	, mSprite(textures, Table[type].texture, Table[type].idleRect)
 	, mFootSenseCount()
 	, mIsMarkedForRemoval(false)
 	, mElapsedTime(sf::Time::Zero)
@@ -42,15 +44,11 @@ Player::Player(Type type, const TextureHolder& textures)
 	, mScaleToggle(true)
 	, mIsDying(false)
 	, mIsSmallPlayerTransformed(false)
-	, mCollisionDispatcher()
-	, mUpdateDispatcher()
 {
 	setup();
 
 	mFireCommand.category = Category::BackLayer;
-	mFireCommand.action = std::bind(&Player::createProjectile, this, _1, std::cref(textures));
-
-	initialDispatching();
+	mFireCommand.action = std::bind(&Player::createProjectile, this, _1, std::ref(projectiles));
 }
 
 void Player::setup()
@@ -65,63 +63,44 @@ void Player::setup()
 	mFootShape.setOutlineThickness(-0.5f);
 	auto footBounds = mFootShape.getLocalBounds();
 	mFootShape.setOrigin(footBounds.width / 2.f, footBounds.height / 2.f);
+
+	updateColliders();
 }
 
-void Player::initialDispatching()
-{
-	Dispatcher airCollision({
-		// Tiles
-		{ Category::Brick, std::bind(&Player::airTileCollision, this, _1, _2) },
-		{ Category::Block, std::bind(&Player::airTileCollision, this, _1, _2) },
-		{ Category::TransformBox, std::bind(&Player::airTileCollision, this, _1, _2) },
-		{ Category::FireBox, std::bind(&Player::airTileCollision, this, _1, _2) },
-		{ Category::ShiftBox, std::bind(&Player::airTileCollision, this, _1, _2) },
-		{ Category::CoinsBox, std::bind(&Player::airTileCollision, this, _1, _2) },
-		{ Category::SoloCoinBox, std::bind(&Player::airTileCollision, this, _1, _2) },
-		{ Category::SolidBox, std::bind(&Player::airTileCollision, this, _1, _2) },
-		// Enemies
-		{ Category::Goomba, std::bind(&Player::airEnemyCollision, this, _1, _2) },
-		{ Category::Troopa, std::bind(&Player::airEnemyCollision, this, _1, _2) },
-		{ Category::Shell, std::bind(&Player::airEnemyCollision, this, _1, _2) },
-		// Items
-		{ Category::Mushroom, std::bind(&Player::mushroomCollision, this, _1, _2) },
-		{ Category::Flower, std::bind(&Player::flowerCollision, this, _1, _2) },
-		{ Category::Star, std::bind(&Player::starCollision, this, _1, _2) },
-	});
-
-	Dispatcher groundCollision({
-		// Tiles
-		{ Category::Brick, std::bind(&Player::groundTileCollision, this, _1, _2) },
-		{ Category::Block, std::bind(&Player::groundTileCollision, this, _1, _2) },
-		{ Category::TransformBox, std::bind(&Player::groundTileCollision, this, _1, _2) },
-		{ Category::FireBox, std::bind(&Player::groundTileCollision, this, _1, _2) },
-		{ Category::ShiftBox, std::bind(&Player::groundTileCollision, this, _1, _2) },
-		{ Category::CoinsBox, std::bind(&Player::groundTileCollision, this, _1, _2) },
-		{ Category::SoloCoinBox, std::bind(&Player::groundTileCollision, this, _1, _2) },
-		{ Category::SolidBox, std::bind(&Player::groundTileCollision, this, _1, _2) },
-		// Enemies
-		{ Category::Goomba, std::bind(&Player::groundEnemyCollision, this, _1, _2) },
-		{ Category::Troopa, std::bind(&Player::groundEnemyCollision, this, _1, _2) },
-		{ Category::Shell, std::bind(&Player::groundEnemyCollision, this, _1, _2) },
-		// Items
-		{ Category::Mushroom, std::bind(&Player::mushroomCollision, this, _1, _2) },
-		{ Category::Flower, std::bind(&Player::flowerCollision, this, _1, _2) },
-		{ Category::Star, std::bind(&Player::starCollision, this, _1, _2) },
-	});
-
-	mCollisionDispatcher.emplace_back(Behavors::Air, airCollision);
-	mCollisionDispatcher.emplace_back(Behavors::Ground, groundCollision);
-	if (mCollisionDispatcher.capacity() > mCollisionDispatcher.size())
-	{
-		mCollisionDispatcher.shrink_to_fit();
-	}
-	mUpdateDispatcher.emplace_back(Behavors::Air, std::bind(&Player::airUpdate, this, _1));
-	mUpdateDispatcher.emplace_back(Behavors::Ground, std::bind(&Player::groundUpdate, this, _1));
-	mUpdateDispatcher.emplace_back(Behavors::Dying, std::bind(&Player::dyingUpdate, this, _1));
-	if (mUpdateDispatcher.capacity() > mUpdateDispatcher.size())
+void Player::updateColliders()
+{
+	setColliders(getTransform().transformRect(mSprite.getGlobalBounds()),
+		getTransform().transformRect(mFootShape.getGlobalBounds()));
+}
+
+const Player::Collisions& Player::getCollisionTable()
+{
+	static const auto table = []()
 	{
-		mUpdateDispatcher.shrink_to_fit();
-	}
+		Collisions table;
+
+		const auto tiles = Category::Brick | Category::Block | Category::TransformBox | Category::FireBox
+			| Category::ShiftBox | Category::CoinsBox | Category::SoloCoinBox | Category::SolidBox;
+		const auto enemies = Category::Goomba | Category::Troopa | Category::Shell;
+
+		for (auto behavor : { Behavors::Air, Behavors::Ground })
+		{
+			// Items
+			table.set(behavor, Category::Mushroom, &Player::mushroomCollision);
+			table.set(behavor, Category::Flower, &Player::flowerCollision);
+			table.set(behavor, Category::Star, &Player::starCollision);
+		}
+
+		table.set(Behavors::Air, tiles, &Player::airTileCollision);
+		table.set(Behavors::Air, enemies, &Player::airEnemyCollision);
+
+		table.set(Behavors::Ground, tiles, &Player::groundTileCollision);
+		table.set(Behavors::Ground, enemies, &Player::groundEnemyCollision);
+
+		return table;
+	}();
+
+	return table;
 }
 
 void Player::airTileCollision(const sf::Vector3f& manifold, SceneNode* other)
@@ -175,7 +154,7 @@ void Player::airEnemyCollision(const sf::Vector3f& manifold, SceneNode* other)
 		mIsDying = true;
 	};
 
-	const static std::array<Function, Type::TypeCount> sideCollision
+	const std::array<Function, Type::TypeCount> sideCollision
 	{
 		sideCollisionSmallPlayer,
 		sideCollisionBigPlayer
@@ -250,7 +229,7 @@ void Player::groundEnemyCollision(const sf::Vector3f& manifold, SceneNode* other
 		mIsDying = true;
 	};
 
-	const static std::array<Function, Type::TypeCount> sideCollision
+	const std::array<Function, Type::TypeCount> sideCollision
 	{
 		sideCollisionSmallPlayer,
 		sideCollisionBigPlayer
@@ -273,6 +252,12 @@ unsigned int Player::getCategory() const
 	return category[mType];
 }
 
+unsigned int Player::getPossibleCategories() const
+{
+	// transformations switch between both
+	return Category::SmallPlayer | Category::BigPlayer;
+}
+
 bool Player::isMarkedForRemoval() const
 {
 	return mIsMarkedForRemoval;
@@ -283,6 +268,12 @@ bool Player::isDying() const
 	return mIsSmallPlayerTransformed || mIsDying;
 }
 
+bool Player::isContinuousCollision() const
+{
+	// jumps are fast enough to pass a brick at a low frame rate, a dying player falls through everything
+	return !isDying();
+}
+
 bool Player::paused()
 {
 	return (mAffects & Pause) == Pause;
@@ -464,11 +455,6 @@ void Player::playEffects(sf::Time dt)
 	mTimer = sf::Time::Zero;
 }
 
-sf::FloatRect Player::getBoundingRect() const
-{
-	return getWorldTransform().transformRect(mSprite.getGlobalBounds());
-}
-
 void Player::updateCurrent(sf::Time dt, CommandQueue& commands)
 {
 	static const sf::Vector2f Gravity(0.f, 25.f);
@@ -482,21 +468,29 @@ void Player::updateCurrent(sf::Time dt, CommandQueue& commands)
 
 	accelerate(Gravity);
 
-	for (const auto& behavor : mUpdateDispatcher)
+	const static std::array<UpdateHandler, Behavors::BehavorCount> updates
 	{
-		if (behavor.first != mBehavors) continue;
+		&Player::airUpdate,
+		&Player::groundUpdate,
+		&Player::dyingUpdate,
+	};
 
-		 behavor.second(dt);
-	}
+	(this->*updates[mBehavors])(dt);
 
 	playEffects(dt);
 
-	if (mAffects & Death) return;
+	if (mAffects & Death)
+	{
+		updateColliders();
+		return;
+	}
 
 	updateDirection(dt);
 
 	updateAnimation(dt);
 
+	updateColliders();
+
 	checkProjectiles();
 
 	checkProjectileLaunch(dt, commands);
@@ -567,11 +561,11 @@ void Player::dyingUpdate(sf::Time dt)
 	setVelocity(vel);
 }
 
-void Player::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
+void Player::drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const
 {
-	target.draw(mSprite, states);
+	batch.draw(mSprite, transform);
 #ifdef Debug
-	target.draw(mFootShape, states);
+	batch.drawRectangle(mFootShape, transform);
 #endif // Debug
 }
 
@@ -580,11 +574,6 @@ void Player::applyForce(sf::Vector2f velocity)
 	accelerate((getFootSenseCount() == 0u) ? sf::Vector2f(velocity.x, 0.f) : velocity);
 }
 
-sf::FloatRect Player::getFootSensorBoundingRect() const
-{
-	return getWorldTransform().transformRect(mFootShape.getGlobalBounds());
-}
-
 void Player::setFootSenseCount(unsigned int count)
 {
 	mFootSenseCount = count;
@@ -597,18 +586,8 @@ unsigned int Player::getFootSenseCount() const
 
 void Player::resolve(const sf::Vector3f& manifold, SceneNode* other)
 {
-	for (const auto& behavor : mCollisionDispatcher)
-	{
-		if (behavor.first != mBehavors) continue;
-
-		for (const auto& collider : behavor.second)
-		{
-			if (collider.first & other->getCategory())
-			{
-				collider.second(manifold, other);
-			}
-		}
-	}
+	getCollisionTable().resolve(*this, mBehavors, manifold, other);
+	updateColliders();
 }
 
 void Player::updateDirection(sf::Time dt)
@@ -718,9 +697,9 @@ void Player::checkProjectiles()
 	mBullets.erase(std::remove_if(mBullets.begin(), mBullets.end(), std::mem_fn(&Projectile::isDestroyed)), mBullets.end());
 }
 
-void Player::createProjectile(SceneNode& node, const TextureHolder& textures)
+void Player::createProjectile(SceneNode& node, ObjectPool<Projectile>& projectiles)
 {
-	auto projectile(std::make_unique<Projectile>(Projectile::PlayerProjectile, textures));
+	auto projectile(projectiles.acquire(Projectile::PlayerProjectile));
 
 	const sf::Vector2f offset(mSprite.getLocalBounds().width / 2.f, -mSprite.getLocalBounds().height / 2.f);
 
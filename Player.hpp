@@ -3,6 +3,9 @@
 
 #include "Command.hpp"
 #include "Projectile.hpp"
+#include "ObjectPool.hpp"
+#include "AtlasSprite.hpp"
+#include "CollisionTable.hpp"
 
 #include <SFML/Graphics/RectangleShape.hpp>
 
@@ -32,7 +35,8 @@ private:
 	{
 		Air,
 		Ground,
-		Dying
+		Dying,
+		BehavorCount
 	};
 
 	enum Direction
@@ -54,13 +58,12 @@ private:
 		Power		= 1 << 6,
 	};
 
-	using DispatchHolder = std::vector<std::pair<Behavors, Dispatcher>>;
-	using FunctionUpdater = std::function<void(sf::Time)>;
-	using UpdateHolder = std::vector<std::pair<Behavors, FunctionUpdater>>;
+	using UpdateHandler = void (Player::*)(sf::Time);
+	using Collisions = CollisionTable<Player, BehavorCount>;
 
 
 public:
-	explicit Player(Type type, const TextureHolder& textures);
+	explicit Player(Type type, const TextureHolder& textures, EntityStore& store, ObjectPool<Projectile>& projectiles);
 
 	void applyForce(sf::Vector2f velocity);
 	void fire();
@@ -74,15 +77,14 @@ public:
 
 
 private:
-	void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const override;
+	void drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const override;
 	void updateCurrent(sf::Time dt, CommandQueue& commands) override;
 
-	sf::FloatRect getBoundingRect() const override;
 	bool isMarkedForRemoval() const override;
 	unsigned int getCategory() const override;
+	unsigned int getPossibleCategories() const override;
 	unsigned int getAbilities() const override;
 
-	sf::FloatRect getFootSensorBoundingRect() const override;
 
 	void setFootSenseCount(unsigned int count) override;
 	unsigned int getFootSenseCount() const override;
@@ -94,15 +96,17 @@ private:
 
 	void checkProjectiles();
 	void checkProjectileLaunch(sf::Time dt, CommandQueue& commands);
-	void createProjectile(SceneNode& node, const TextureHolder& textures);
+	void createProjectile(SceneNode& node, ObjectPool<Projectile>& projectiles);
 
 	void setup();
+	void updateColliders();
 
 	bool scalingEffect(sf::Time dt, sf::Vector2f targetScale);
 	void playEffects(sf::Time dt);
 	bool isDying() const override;
+	bool isContinuousCollision() const override;
 
-	void initialDispatching();
+	static const Collisions& getCollisionTable();
 
 	void airTileCollision(const sf::Vector3f& manifold, SceneNode* other);
 	void airEnemyCollision(const sf::Vector3f& manifold, SceneNode* other);
@@ -123,7 +127,7 @@ private:
 private:
 	Type mType;
 	Behavors mBehavors;
-	sf::Sprite mSprite;
+	AtlasSprite mSprite;
 	sf::RectangleShape mFootShape;
 	unsigned int mFootSenseCount;
 	bool mIsMarkedForRemoval;
@@ -152,6 +156,4 @@ private:
 	bool mIsDying;
 	bool mIsSmallPlayerTransformed;
 
-	DispatchHolder mCollisionDispatcher;
-	UpdateHolder mUpdateDispatcher;
 };
\ No newline at end of file
@@ -3,7 +3,11 @@
 #include "Player.hpp"
 
 
-PlayerController::PlayerController()
+PlayerController::PlayerController(bool useKeyboard)
+	: mKeyBinding()
+	, mActionBinding()
+	, mActiveActions()
+	, mUseKeyboard(useKeyboard)
 {
 	mKeyBinding.emplace(sf::Keyboard::Left, MoveLeft);
 	mKeyBinding.emplace(sf::Keyboard::Right, MoveRight);
@@ -28,10 +32,31 @@ void PlayerController::handleEvent(const sf::Event& event, CommandQueue& command
 
 void PlayerController::handleRealtimeInput(CommandQueue& commands)
 {
-	for (const auto& pair : mKeyBinding)
+	if (mUseKeyboard)
 	{
-		if (sf::Keyboard::isKeyPressed(pair.first) && isRealtimeAction(pair.second))
-			commands.push(mActionBinding[pair.second]);
+		for (const auto& pair : mKeyBinding)
+		{
+			if (sf::Keyboard::isKeyPressed(pair.first) && isRealtimeAction(pair.second))
+				commands.push(mActionBinding[pair.second]);
+		}
+	}
+
+	for (auto action : mActiveActions)
+		commands.push(mActionBinding[action]);
+}
+
+void PlayerController::handleAction(Action action, bool pressed, CommandQueue& commands)
+{
+	if (isRealtimeAction(action))
+	{
+		if (pressed)
+			mActiveActions.insert(action);
+		else
+			mActiveActions.erase(action);
+	}
+	else if (pressed)
+	{
+		commands.push(mActionBinding[action]);
 	}
 }
 
@@ -8,6 +8,7 @@
 #include <SFML/System/Clock.hpp>
 
 #include <map>
+#include <set>
 
 
 class CommandQueue;
@@ -32,11 +33,14 @@ private:
 
 
 public:
-	PlayerController();
+	explicit PlayerController(bool useKeyboard = true);
 
 	void handleEvent(const sf::Event& event, CommandQueue& commands);
 	void handleRealtimeInput(CommandQueue& commands);
 
+	// scripted input, realtime actions stay active until released
+	void handleAction(Action action, bool pressed, CommandQueue& commands);
+
 
 private:
 	void initializeActions();
@@ -46,4 +50,6 @@ private:
 private:
 	KeyMap mKeyBinding;
 	ActionMap mActionBinding;
+	std::set<Action> mActiveActions;
+	bool mUseKeyboard;
 };
@@ -0,0 +1,133 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+
+namespace
+{
+	unsigned int threadIndex()
+	{
+		static std::atomic<unsigned int> next(0u);
+		thread_local const auto index = next++;
+		return index;
+	}
+
+	void writeEscaped(std::ostream& stream, const char* text)
+	{
+		for (; *text; ++text)
+		{
+			if (*text == '"' || *text == '\\')
+				stream << '\\';
+			stream << *text;
+		}
+	}
+}
+
+Profiler::Profiler()
+	: mEpoch(std::chrono::steady_clock::now())
+	, mNext(0u)
+	, mSlots(new Slot[Capacity]())
+{
+}
+
+Profiler& Profiler::instance()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+std::int64_t Profiler::now() const
+{
+	using namespace std::chrono;
+	return duration_cast<microseconds>(steady_clock::now() - mEpoch).count();
+}
+
+void Profiler::record(const char* name, std::int64_t start, std::int64_t end)
+{
+	const auto sequence = mNext.fetch_add(1u, std::memory_order_relaxed);
+	auto& slot = mSlots[sequence & (Capacity - 1u)];
+
+	slot.sequence.store(0u, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.start.store(start, std::memory_order_relaxed);
+	slot.duration.store(end - start, std::memory_order_relaxed);
+	slot.thread.store(threadIndex(), std::memory_order_relaxed);
+
+	slot.sequence.store(sequence + 1u, std::memory_order_release);
+}
+
+std::uint64_t Profiler::collect(std::uint64_t from, std::vector<Span>& spans) const
+{
+	const auto end = mNext.load(std::memory_order_acquire);
+	const auto begin = std::max(from, end > Capacity ? end - Capacity : 0u);
+
+	for (auto sequence = begin; sequence < end; ++sequence)
+	{
+		const auto& slot = mSlots[sequence & (Capacity - 1u)];
+
+		// skip slots still being written or already overwritten
+		if (slot.sequence.load(std::memory_order_acquire) != sequence + 1u) continue;
+
+		Span span;
+		span.name = slot.name.load(std::memory_order_relaxed);
+		span.start = slot.start.load(std::memory_order_relaxed);
+		span.duration = slot.duration.load(std::memory_order_relaxed);
+		span.thread = slot.thread.load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.load(std::memory_order_relaxed) != sequence + 1u) continue;
+
+		spans.push_back(span);
+	}
+
+	return end;
+}
+
+bool Profiler::exportTrace(const std::string& filename) const
+{
+	std::vector<Span> spans;
+	collect(0u, spans);
+
+	std::ofstream file(filename);
+	if (!file)
+		return false;
+
+	// complete events ("ph":"X"), timestamps in microseconds
+	file << "{\"traceEvents\":[\n";
+	for (auto i = std::size_t(0u); i < spans.size(); ++i)
+	{
+		const auto& span = spans[i];
+
+		file << "{\"name\":\"";
+		writeEscaped(file, span.name);
+		file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << span.thread
+			 << ",\"ts\":" << span.start << ",\"dur\":" << span.duration << "}"
+			 << (i + 1u < spans.size() ? ",\n" : "\n");
+	}
+	file << "],\"displayTimeUnit\":\"ms\"}\n";
+
+	return static_cast<bool>(file);
+}
+
+ProfileScope::ProfileScope(const char* name, sf::Time* elapsed)
+	: mName(name)
+	, mElapsed(elapsed)
+	, mStart(Profiler::instance().now())
+{
+}
+
+ProfileScope::~ProfileScope()
+{
+	auto& profiler = Profiler::instance();
+	const auto end = profiler.now();
+
+#ifdef PROFILING
+	profiler.record(mName, mStart, end);
+#endif // PROFILING
+
+	if (mElapsed)
+		*mElapsed = sf::microseconds(end - mStart);
+}
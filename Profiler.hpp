@@ -0,0 +1,92 @@
+#pragma once
+
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// comment out to compile every PROFILE_SCOPE away, PROFILE_PHASE keeps timing
+#define PROFILING
+
+
+// Named time spans kept in a fixed lock-free ring buffer, only the newest
+// Capacity spans survive. Any thread may record. Read back by ProfilerOverlay
+// and exported as Chrome trace-event JSON for chrome://tracing or Perfetto.
+class Profiler final : private sf::NonCopyable
+{
+public:
+	static const std::size_t Capacity = 1u << 14;
+
+	struct Span
+	{
+		const char* name;		// a string literal, compared by address
+		std::int64_t start;		// microseconds since the profiler was created
+		std::int64_t duration;	// microseconds
+		unsigned int thread;
+	};
+
+
+public:
+	static Profiler& instance();
+
+	std::int64_t now() const;
+	void record(const char* name, std::int64_t start, std::int64_t end);
+
+	// appends the spans recorded from sequence number 'from' on, oldest first,
+	// and returns the sequence number to continue from
+	std::uint64_t collect(std::uint64_t from, std::vector<Span>& spans) const;
+	bool exportTrace(const std::string& filename) const;
+
+
+private:
+	Profiler();
+
+
+private:
+	// seqlock per slot, sequence is 0 while a writer fills it
+	struct Slot
+	{
+		std::atomic<std::uint64_t> sequence;
+		std::atomic<const char*> name;
+		std::atomic<std::int64_t> start;
+		std::atomic<std::int64_t> duration;
+		std::atomic<unsigned int> thread;
+	};
+
+	std::chrono::steady_clock::time_point mEpoch;
+	std::atomic<std::uint64_t> mNext;
+	std::unique_ptr<Slot[]> mSlots;
+};
+
+
+// Records the span from its construction to its destruction, and stores
+// its length in 'elapsed' if given.
+class ProfileScope final : private sf::NonCopyable
+{
+public:
+	explicit ProfileScope(const char* name, sf::Time* elapsed = nullptr);
+	~ProfileScope();
+
+
+private:
+	const char* mName;
+	sf::Time* mElapsed;
+	std::int64_t mStart;
+};
+
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_PHASE(name, elapsed) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name, &(elapsed))
+
+#ifdef PROFILING
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif // PROFILING
@@ -0,0 +1,80 @@
+#include "ProfilerOverlay.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+
+namespace
+{
+	// weight of the newest span, about the last 60 samples dominate
+	const auto Smoothing = 1.f / 60.f;
+}
+
+ProfilerOverlay::ProfilerOverlay()
+	: mFont()
+	, mText()
+	, mBackground()
+	, mSpans()
+	, mEntries()
+	, mSequence(0u)
+{
+	if (!mFont.loadFromFile("Media/arial.ttf"))
+		throw std::runtime_error("can't load fonts");
+
+	mText.setFont(mFont);
+	mText.setCharacterSize(12u);
+	mText.setPosition(10.f, 10.f);
+
+	mBackground.setFillColor(sf::Color(0, 0, 0, 160));
+	mBackground.setPosition(5.f, 5.f);
+}
+
+void ProfilerOverlay::update()
+{
+	mSpans.clear();
+	mSequence = Profiler::instance().collect(mSequence, mSpans);
+
+	for (const auto& span : mSpans)
+	{
+		auto& entry = getEntry(span.name);
+		const auto milliseconds = span.duration / 1000.f;
+
+		entry.average += (milliseconds - entry.average) * Smoothing;
+		entry.peak = std::max(entry.peak * (1.f - Smoothing), milliseconds);
+	}
+
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(3);
+	for (const auto& entry : mEntries)
+		stream << entry.name << ":  " << entry.average << " ms avg,  " << entry.peak << " ms peak\n";
+
+	mText.setString(stream.str());
+
+	auto bounds = mText.getLocalBounds();
+	mBackground.setSize({ bounds.width + 20.f, bounds.height + 20.f });
+}
+
+ProfilerOverlay::Entry& ProfilerOverlay::getEntry(const char* name)
+{
+	auto found = std::find_if(mEntries.begin(), mEntries.end(), [name](const Entry& entry)
+	{
+		return entry.name == name || std::strcmp(entry.name, name) == 0;
+	});
+
+	if (found != mEntries.end())
+		return *found;
+
+	mEntries.push_back({ name, 0.f, 0.f });
+	return mEntries.back();
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	target.draw(mBackground, states);
+	target.draw(mText, states);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+
+#include "Profiler.hpp"
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+
+#include <vector>
+
+
+// On-screen table of the profiled spans, rolling average and peak per name,
+// drawn in window coordinates.
+class ProfilerOverlay final : public sf::Drawable, private sf::NonCopyable
+{
+	struct Entry
+	{
+		const char* name;
+		float average;	// milliseconds
+		float peak;
+	};
+
+
+public:
+	ProfilerOverlay();
+
+	// folds the spans recorded since the last call into the averages
+	void update();
+
+
+private:
+	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+	Entry& getEntry(const char* name);
+
+
+private:
+	sf::Font mFont;
+	sf::Text mText;
+	sf::RectangleShape mBackground;
+	std::vector<Profiler::Span> mSpans;
+	std::vector<Entry> mEntries;
+	std::uint64_t mSequence;
+};
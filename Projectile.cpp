@@ -1,19 +1,40 @@
 #include "Projectile.hpp"
-#include "ResourceHolder.hpp"
+#include "TextureAtlas.hpp"
+#include "SpriteBatch.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
-#include <iostream>
 
 
-Projectile::Projectile(Type type, const TextureHolder& textures)
-	: mType(type)
-	, mSprite(textures.get(Textures::Items), sf::IntRect(6 * 16, 9 * 16, 8, 8))
+namespace
+{
+	const sf::IntRect FlyingRect(6 * 16, 9 * 16, 8, 8);
+}
+
+Projectile::Projectile(Type type, const TextureHolder& textures, EntityStore& store)
+	: Entity(store)
+	, mType(type)
+	, mSprite(textures, Textures::Items, FlyingRect)
 	, mIsMarkedForRemoval(false)
 	, mTimeDely(sf::Time::Zero)
 	, mIsDying(false)
 {
 	auto bounds = mSprite.getLocalBounds();
 	mSprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
+
+	updateColliders();
+}
+
+void Projectile::reset(Type type)
+{
+	mType = type;
+	mSprite.setTextureRect(FlyingRect);
+	mIsMarkedForRemoval = false;
+	mTimeDely = sf::Time::Zero;
+	mIsDying = false;
+
+	setRotation(0.f);
+	updateColliders();
+	revive();
 }
 
 unsigned int Projectile::getCategory() const
@@ -26,9 +47,20 @@ bool Projectile::isMarkedForRemoval() const
 	return mIsMarkedForRemoval;
 }
 
-sf::FloatRect Projectile::getBoundingRect() const
+bool Projectile::isUpdateIndependent() const
 {
-	return getWorldTransform().transformRect(mSprite.getGlobalBounds());
+	return true;
+}
+
+bool Projectile::isContinuousCollision() const
+{
+	return true;
+}
+
+void Projectile::updateColliders()
+{
+	// no foot sensor, projectiles only bounce off what they hit
+	setColliders(getTransform().transformRect(mSprite.getGlobalBounds()));
 }
 
 void Projectile::updateCurrent(sf::Time dt, CommandQueue& commands)
@@ -37,7 +69,6 @@ void Projectile::updateCurrent(sf::Time dt, CommandQueue& commands)
 
 	if (isDestroyed())
 	{
-		std::cout << "dead\n";
 		mIsMarkedForRemoval = true;
 		return;
 	}
@@ -54,13 +85,14 @@ void Projectile::updateCurrent(sf::Time dt, CommandQueue& commands)
 	accelerate(Gravity);
 
 	rotate(10.f);
+	updateColliders();
 
 	Entity::updateCurrent(dt, commands);
 }
 
-void Projectile::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
+void Projectile::drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const
 {
-	target.draw(mSprite, states);
+	batch.draw(mSprite, transform);
 }
 
 void Projectile::resolve(const sf::Vector3f& manifold, SceneNode* other)
@@ -96,4 +128,6 @@ void Projectile::resolve(const sf::Vector3f& manifold, SceneNode* other)
 		break;
 	default: break;
 	}
+
+	updateColliders();
 }
\ No newline at end of file
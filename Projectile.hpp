@@ -3,8 +3,8 @@
 
 #include "Entity.hpp"
 #include "ResourceIdentifiers.hpp"
+#include "AtlasSprite.hpp"
 
-#include <SFML/Graphics/Sprite.hpp>
 
 
 class Projectile final : public Entity
@@ -18,23 +18,29 @@ public:
 
 
 public:
-	explicit Projectile(Type type, const TextureHolder& textures);
+	explicit Projectile(Type type, const TextureHolder& textures, EntityStore& store);
+
+	// fresh state for an instance recycled by its ObjectPool
+	void reset(Type type);
 
 
 private:
-	void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const override;
+	void drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const override;
 	void updateCurrent(sf::Time dt, CommandQueue& commands) override;
 
-	sf::FloatRect getBoundingRect() const override;
 	bool isMarkedForRemoval() const override;
+	bool isUpdateIndependent() const override;
+	bool isContinuousCollision() const override;
 	unsigned int getCategory() const override;
 
 	void resolve(const sf::Vector3f& manifold, SceneNode* otherType) override;
 
+	void updateColliders();
+
 
 private:
 	Type mType;
-	sf::Sprite mSprite;
+	AtlasSprite mSprite;
 	bool mIsMarkedForRemoval;
 	sf::Time mTimeDely;
 	bool mIsDying;
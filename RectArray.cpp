@@ -0,0 +1,44 @@
+#include "RectArray.hpp"
+
+
+void RectArray::clear()
+{
+	mLeft.clear();
+	mTop.clear();
+	mRight.clear();
+	mBottom.clear();
+}
+
+void RectArray::reserve(std::size_t count)
+{
+	mLeft.reserve(count);
+	mTop.reserve(count);
+	mRight.reserve(count);
+	mBottom.reserve(count);
+}
+
+std::size_t RectArray::size() const
+{
+	return mLeft.size();
+}
+
+void RectArray::push(const sf::FloatRect& rect)
+{
+	mLeft.emplace_back(rect.left);
+	mTop.emplace_back(rect.top);
+	mRight.emplace_back(rect.left + rect.width);
+	mBottom.emplace_back(rect.top + rect.height);
+}
+
+void RectArray::set(std::size_t index, const sf::FloatRect& rect)
+{
+	mLeft[index] = rect.left;
+	mTop[index] = rect.top;
+	mRight[index] = rect.left + rect.width;
+	mBottom[index] = rect.top + rect.height;
+}
+
+sf::FloatRect RectArray::get(std::size_t index) const
+{
+	return{ mLeft[index], mTop[index], mRight[index] - mLeft[index], mBottom[index] - mTop[index] };
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <algorithm>
+#include <vector>
+
+
+// Structure of arrays store of axis aligned rects, edges are kept in
+// separate contiguous float arrays so overlap tests stay cache friendly.
+// Overlap follows sf::Rect::intersects, touching edges do not count.
+class RectArray final
+{
+public:
+	void clear();
+	void reserve(std::size_t count);
+	std::size_t size() const;
+
+	void push(const sf::FloatRect& rect);
+	void set(std::size_t index, const sf::FloatRect& rect);
+	sf::FloatRect get(std::size_t index) const;
+
+	float getLeft(std::size_t index) const
+	{
+		return mLeft[index];
+	}
+
+	float getRight(std::size_t index) const
+	{
+		return mRight[index];
+	}
+
+	bool intersects(std::size_t index, const sf::FloatRect& rect) const
+	{
+		return std::max(mLeft[index], rect.left) < std::min(mRight[index], rect.left + rect.width)
+			&& std::max(mTop[index], rect.top) < std::min(mBottom[index], rect.top + rect.height);
+	}
+
+	bool intersects(std::size_t index, const RectArray& other, std::size_t otherIndex) const
+	{
+		return std::max(mLeft[index], other.mLeft[otherIndex]) < std::min(mRight[index], other.mRight[otherIndex])
+			&& std::max(mTop[index], other.mTop[otherIndex]) < std::min(mBottom[index], other.mBottom[otherIndex]);
+	}
+
+
+private:
+	std::vector<float> mLeft;
+	std::vector<float> mTop;
+	std::vector<float> mRight;
+	std::vector<float> mBottom;
+};
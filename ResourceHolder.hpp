@@ -18,6 +18,7 @@ class ResourceHolder final : private sf::NonCopyable
 
 public:
 	void load(Identifier id, const std::string& filename);
+	void insert(Identifier id, std::unique_ptr<Resource> resource);
 
 	Resource& get(Identifier id);
 	const Resource& get(Identifier id) const;
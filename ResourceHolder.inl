@@ -10,6 +10,12 @@ void ResourceHolder<Resource, Identifier>::load(Identifier id, const std::string
 	insertResource(id, std::move(resource));
 }
 
+template <typename Resource, typename Identifier>
+void ResourceHolder<Resource, Identifier>::insert(Identifier id, std::unique_ptr<Resource> resource)
+{
+	insertResource(id, std::move(resource));
+}
+
 template <typename Resource, typename Identifier>
 Resource& ResourceHolder<Resource, Identifier>::get(Identifier id)
 {
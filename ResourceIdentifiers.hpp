@@ -22,4 +22,7 @@ namespace Textures
 template <typename Resource, typename Identifier>
 class ResourceHolder;
 
-using TextureHolder = ResourceHolder<sf::Texture, Textures::ID>;
+class TextureAtlas;
+
+// all sprite sheets are packed into one atlas texture
+using TextureHolder = TextureAtlas;
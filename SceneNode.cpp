@@ -1,5 +1,8 @@
 #include "SceneNode.hpp"
 #include "Command.hpp"
+#include "CommandBus.hpp"
+#include "ObjectPool.hpp"
+#include "SpriteBatch.hpp"
 
 #include <cassert>
 
@@ -8,12 +11,27 @@ SceneNode::SceneNode(Category::Type category)
 	: mChildren()
 	, mParent(nullptr)
 	, mDefaultCategory(category)
+	, mPool(nullptr)
+	, mCommandBus(nullptr)
+	, mCommandCategories(0u)
+	, mCommandStamp(0u)
+	, mWorldTransform()
+	, mIsWorldTransformDirty(true)
+	, mIsWorldTransformCached(true)
 {
 }
 
 void SceneNode::attachChild(Ptr child)
 {
+	// a child would cache a transform built on one that is never invalidated
+	assert(mIsWorldTransformCached);
+
 	child->mParent = this;
+	child->invalidateWorldTransform();
+
+	if (mCommandBus)
+		mCommandBus->attach(*child);
+
 	mChildren.emplace_back(std::move(child));
 }
 
@@ -28,7 +46,12 @@ SceneNode::Ptr SceneNode::detachChild(const SceneNode& node)
 	assert(found != mChildren.end());
 
 	auto result = std::move(*found);
+
+	if (result->mCommandBus)
+		result->mCommandBus->detach(*result);
+
 	result->mParent = nullptr;
+	result->invalidateWorldTransform();
 	mChildren.erase(found);
 	return result;
 }
@@ -51,20 +74,96 @@ void SceneNode::updateChildren(sf::Time dt, CommandQueue& commands)
 
 void SceneNode::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	states.transform *= getTransform();
+	SpriteBatch batch;
+	batch.begin(target);
+	drawBatched(batch, states.transform);
+	batch.end();
+}
+
+void SceneNode::drawBatched(SpriteBatch& batch, sf::Transform transform) const
+{
+	transform *= getLocalTransform();
+
+	drawCurrentBatched(batch, transform);
+
+	for (const auto& child : mChildren)
+		child->drawBatched(batch, transform);
+}
+
+void SceneNode::drawCurrentBatched(SpriteBatch&, const sf::Transform&) const
+{
+}
 
-	drawCurrent(target, states);
-	drawChildren(target, states);
+void SceneNode::setPosition(float x, float y)
+{
+	sf::Transformable::setPosition(x, y);
+	invalidateWorldTransform();
 }
 
-void SceneNode::drawCurrent(sf::RenderTarget&, sf::RenderStates) const
+void SceneNode::setPosition(const sf::Vector2f& position)
 {
+	sf::Transformable::setPosition(position);
+	invalidateWorldTransform();
 }
 
-void SceneNode::drawChildren(sf::RenderTarget& target, sf::RenderStates states) const
+void SceneNode::move(float offsetX, float offsetY)
 {
-	for (const auto& child : mChildren)
-		child->draw(target, states);
+	sf::Transformable::move(offsetX, offsetY);
+	invalidateWorldTransform();
+}
+
+void SceneNode::move(const sf::Vector2f& offset)
+{
+	sf::Transformable::move(offset);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setRotation(float angle)
+{
+	sf::Transformable::setRotation(angle);
+	invalidateWorldTransform();
+}
+
+void SceneNode::rotate(float angle)
+{
+	sf::Transformable::rotate(angle);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setScale(float factorX, float factorY)
+{
+	sf::Transformable::setScale(factorX, factorY);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setScale(const sf::Vector2f& factors)
+{
+	sf::Transformable::setScale(factors);
+	invalidateWorldTransform();
+}
+
+void SceneNode::scale(float factorX, float factorY)
+{
+	sf::Transformable::scale(factorX, factorY);
+	invalidateWorldTransform();
+}
+
+void SceneNode::scale(const sf::Vector2f& factor)
+{
+	sf::Transformable::scale(factor);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setOrigin(float x, float y)
+{
+	sf::Transformable::setOrigin(x, y);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setOrigin(const sf::Vector2f& origin)
+{
+	sf::Transformable::setOrigin(origin);
+	invalidateWorldTransform();
 }
 
 sf::Vector2f SceneNode::getWorldPosition() const
@@ -72,25 +171,49 @@ sf::Vector2f SceneNode::getWorldPosition() const
 	return getWorldTransform() * sf::Vector2f();
 }
 
-sf::Transform SceneNode::getWorldTransform() const
+const sf::Transform& SceneNode::getWorldTransform() const
+{
+	if (mIsWorldTransformDirty || !mIsWorldTransformCached)
+	{
+		mWorldTransform = (mParent) ? mParent->getWorldTransform() * getLocalTransform() : getLocalTransform();
+		mIsWorldTransformDirty = false;
+	}
+
+	return mWorldTransform;
+}
+
+sf::Transform SceneNode::getLocalTransform() const
+{
+	return getTransform();
+}
+
+void SceneNode::disableWorldTransformCache()
+{
+	assert(mChildren.empty());
+
+	mIsWorldTransformCached = false;
+}
+
+void SceneNode::invalidateWorldTransform()
 {
-	auto transform = sf::Transform::Identity;
+	// a dirty node always has a dirty subtree, nothing left to do
+	if (mIsWorldTransformDirty) return;
 
-	for (const auto* node = this; node != nullptr; node = node->mParent)
-		transform = node->getTransform() * transform;
+	mIsWorldTransformDirty = true;
 
-	return transform;
+	for (const auto& child : mChildren)
+		child->invalidateWorldTransform();
 }
 
-void SceneNode::onCommand(const Command& command)
+void SceneNode::setCommandBus(CommandBus& bus)
 {
-	// Command current node, if category matches
-	if (command.category & getCategory())
-		command.action(*this);
+	// root only, the bus owner is not a member of it
+	assert(!mParent);
+
+	mCommandBus = &bus;
 
-	// Command children
 	for (const auto& child : mChildren)
-		child->onCommand(command);
+		bus.attach(*child);
 }
 
 unsigned int SceneNode::getCategory() const
@@ -98,18 +221,49 @@ unsigned int SceneNode::getCategory() const
 	return mDefaultCategory;
 }
 
+unsigned int SceneNode::getPossibleCategories() const
+{
+	return getCategory();
+}
+
 void SceneNode::removeWrecks()
 {
+	for (auto& child : mChildren)
+	{
+		if (!child->isMarkedForRemoval()) continue;
+
+		// Leave the command bus before the nodes are gone
+		if (mCommandBus)
+			mCommandBus->detach(*child);
+
+		// Pooled nodes are kept for reuse, leaving an empty slot behind
+		if (child->mPool)
+		{
+			child->mParent = nullptr;
+			child->mPool->recycle(std::move(child));
+		}
+	}
+
 	// Remove all children which request so
 	mChildren.erase(
 		std::remove_if(mChildren.begin(), mChildren.end(),
-			std::mem_fn(&SceneNode::isMarkedForRemoval)),
+			[](const Ptr& child) { return !child || child->isMarkedForRemoval(); }),
 		mChildren.end());
 
 	// Call function recursively for all remaining children
 	std::for_each(mChildren.begin(), mChildren.end(), std::mem_fn(&SceneNode::removeWrecks));
 }
 
+bool SceneNode::isUpdateIndependent() const
+{
+	return false;
+}
+
+bool SceneNode::isContinuousCollision() const
+{
+	return false;
+}
+
 sf::FloatRect SceneNode::getBoundingRect() const
 {
 	return sf::FloatRect();
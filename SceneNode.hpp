@@ -12,12 +12,14 @@
 #include <vector>
 #include <memory>
 #include <set>
-#include <unordered_map>
 #include <functional>
 #include <iostream>
 
 struct Command;
 class CommandQueue;
+class CommandBus;
+class SpriteBatch;
+class NodePool;
 
 
 class SceneNode : public sf::Transformable, public sf::Drawable, private sf::NonCopyable
@@ -26,7 +28,6 @@ public:
 	using Ptr = std::unique_ptr<SceneNode>;
 	using Pair = std::pair<SceneNode*, SceneNode*>;
 	using Function = std::function<void(const sf::Vector3f&, SceneNode*)>;
-	using Dispatcher = std::unordered_map<unsigned int, Function>;
 
 
 public:
@@ -36,14 +37,38 @@ public:
 	Ptr detachChild(const SceneNode& node);
 
 	void update(sf::Time dt, CommandQueue& commands);
+	// draws the subtree through batch, same result as drawing it directly
+	void drawBatched(SpriteBatch& batch, sf::Transform transform) const;
+
+	// hide sf::Transformable setters so every change invalidates the cached world transform
+	void setPosition(float x, float y);
+	void setPosition(const sf::Vector2f& position);
+	void move(float offsetX, float offsetY);
+	void move(const sf::Vector2f& offset);
+	void setRotation(float angle);
+	void rotate(float angle);
+	void setScale(float factorX, float factorY);
+	void setScale(const sf::Vector2f& factors);
+	void scale(float factorX, float factorY);
+	void scale(const sf::Vector2f& factor);
+	void setOrigin(float x, float y);
+	void setOrigin(const sf::Vector2f& origin);
 
 	sf::Vector2f getWorldPosition() const;
-	sf::Transform getWorldTransform() const;
+	const sf::Transform& getWorldTransform() const;
 
-	void onCommand(const Command& command);
+	void setCommandBus(CommandBus& bus);
 	virtual unsigned int getCategory() const;
+	// every category the node may report during its life, used for bus membership
+	virtual unsigned int getPossibleCategories() const;
 
 	void removeWrecks();
+	// true if updating the node touches only its own subtree and pushes commands,
+	// so ParallelUpdater may run it on a worker thread
+	virtual bool isUpdateIndependent() const;
+	// fast movers are swept from where their last update started,
+	// so they can't pass through a thin tile within one step
+	virtual bool isContinuousCollision() const;
 	virtual sf::FloatRect getBoundingRect() const;
 	virtual bool isDestroyed() const;
 
@@ -61,19 +86,40 @@ public:
 	virtual sf::Vector2f getVelocity() const;
 	virtual bool isPlayerRightFace() const;
 
+protected:
+	// the transform relative to the parent, sf::Transformable's unless a node keeps its position elsewhere
+	virtual sf::Transform getLocalTransform() const;
+	// for nodes whose local transform changes behind the setters, recomputed on every query
+	void disableWorldTransformCache();
+
 private:
 	virtual void updateCurrent(sf::Time dt, CommandQueue& commands);
 	void updateChildren(sf::Time dt, CommandQueue& commands);
 
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
-	virtual void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
-	void drawChildren(sf::RenderTarget& target, sf::RenderStates states) const;
+	// the only drawing hook, direct draws of a node go through a batch as well
+	virtual void drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const;
 
 	virtual bool isMarkedForRemoval() const;
 
+	void invalidateWorldTransform();
+
 
 private:
 	std::vector<Ptr> mChildren;
 	SceneNode* mParent;
 	Category::Type mDefaultCategory;
+
+	friend class NodePool;
+	NodePool* mPool; // takes the node back in removeWrecks, null when it is simply deleted
+
+	friend class CommandBus;
+	friend class ParallelUpdater;
+	CommandBus* mCommandBus;
+	unsigned int mCommandCategories;
+	unsigned int mCommandStamp;
+
+	mutable sf::Transform mWorldTransform;
+	mutable bool mIsWorldTransformDirty;
+	bool mIsWorldTransformCached;
 };
\ No newline at end of file
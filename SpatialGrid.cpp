@@ -0,0 +1,101 @@
+#include "SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+SpatialGrid::SpatialGrid(float cellSize)
+	: mCellSize(cellSize)
+	, mOrigin()
+	, mColumns(1)
+	, mRows(1)
+	, mCells(1)
+	, mVisited()
+	, mQueryStamp(0u)
+{
+}
+
+void SpatialGrid::reset(const sf::FloatRect& bounds)
+{
+	mOrigin = { bounds.left, bounds.top };
+	mColumns = std::max(1, static_cast<int>(std::ceil(bounds.width / mCellSize)));
+	mRows = std::max(1, static_cast<int>(std::ceil(bounds.height / mCellSize)));
+
+	mCells.clear();
+	mCells.resize(mColumns * mRows);
+}
+
+void SpatialGrid::insert(std::size_t id, const sf::FloatRect& rect)
+{
+	const auto range = getCellRange(rect);
+
+	for (auto y = range.top; y <= range.bottom; ++y)
+	{
+		for (auto x = range.left; x <= range.right; ++x)
+		{
+			mCells[x + y * mColumns].emplace_back(id);
+		}
+	}
+
+	if (id >= mVisited.size())
+		mVisited.resize(id + 1, 0u);
+}
+
+void SpatialGrid::remove(std::size_t id, const sf::FloatRect& rect)
+{
+	// rect must be the one id was inserted with
+	const auto range = getCellRange(rect);
+
+	for (auto y = range.top; y <= range.bottom; ++y)
+	{
+		for (auto x = range.left; x <= range.right; ++x)
+		{
+			auto& cell = mCells[x + y * mColumns];
+			cell.erase(std::remove(cell.begin(), cell.end(), id), cell.end());
+		}
+	}
+}
+
+void SpatialGrid::query(const sf::FloatRect& area, std::vector<std::size_t>& result) const
+{
+	result.clear();
+
+	if (++mQueryStamp == 0u)
+	{
+		std::fill(mVisited.begin(), mVisited.end(), 0u);
+		mQueryStamp = 1u;
+	}
+
+	const auto range = getCellRange(area);
+
+	for (auto y = range.top; y <= range.bottom; ++y)
+	{
+		for (auto x = range.left; x <= range.right; ++x)
+		{
+			for (auto id : mCells[x + y * mColumns])
+			{
+				if (mVisited[id] == mQueryStamp) continue;
+
+				mVisited[id] = mQueryStamp;
+				result.emplace_back(id);
+			}
+		}
+	}
+}
+
+SpatialGrid::CellRange SpatialGrid::getCellRange(const sf::FloatRect& rect) const
+{
+	auto toCell = [this](float position, float origin, int count)
+	{
+		auto cell = static_cast<int>(std::floor((position - origin) / mCellSize));
+		return std::min(std::max(cell, 0), count - 1);
+	};
+
+	return
+	{
+		toCell(rect.left, mOrigin.x, mColumns),
+		toCell(rect.top, mOrigin.y, mRows),
+		toCell(rect.left + rect.width, mOrigin.x, mColumns),
+		toCell(rect.top + rect.height, mOrigin.y, mRows)
+	};
+}
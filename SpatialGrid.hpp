@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+#include <vector>
+
+
+// Uniform grid of square cells, used as collision broadphase. Persistent,
+// ids are kept up to date with insert and remove.
+// Ids are inserted into every cell their rect overlaps; anything outside
+// the grid bounds is clamped into the border cells.
+class SpatialGrid final : private sf::NonCopyable
+{
+	struct CellRange
+	{
+		int left;
+		int top;
+		int right;
+		int bottom;
+	};
+
+
+public:
+	explicit SpatialGrid(float cellSize = 16.f);
+
+	void reset(const sf::FloatRect& bounds);
+
+	void insert(std::size_t id, const sf::FloatRect& rect);
+	void remove(std::size_t id, const sf::FloatRect& rect);
+
+	// Collects every id sharing a cell with area, each id reported once
+	void query(const sf::FloatRect& area, std::vector<std::size_t>& result) const;
+
+
+private:
+	CellRange getCellRange(const sf::FloatRect& rect) const;
+
+
+private:
+	float mCellSize;
+	sf::Vector2f mOrigin;
+	int mColumns;
+	int mRows;
+	std::vector<std::vector<std::size_t>> mCells;
+	mutable std::vector<unsigned int> mVisited;
+	mutable unsigned int mQueryStamp;
+};
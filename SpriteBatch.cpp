@@ -0,0 +1,160 @@
+#include "SpriteBatch.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+SpriteBatch::SpriteBatch()
+	: mTarget(nullptr)
+	, mVertices(sf::Quads)
+	, mRectangles(sf::Quads)
+	, mTexture(nullptr)
+	, mDrawCalls(0u)
+{
+}
+
+void SpriteBatch::begin(sf::RenderTarget& target)
+{
+	mTarget = &target;
+	mVertices.clear();
+	mRectangles.clear();
+	mTexture = nullptr;
+	mDrawCalls = 0u;
+}
+
+void SpriteBatch::end()
+{
+	flush();
+
+	if (mRectangles.getVertexCount() != 0)
+	{
+		mTarget->draw(mRectangles);
+		mDrawCalls++;
+		mRectangles.clear();
+	}
+
+	mTarget = nullptr;
+}
+
+void SpriteBatch::draw(const sf::Sprite& sprite, const sf::Transform& transform)
+{
+	setTexture(sprite.getTexture());
+
+	// same corners and texture coordinates sf::Sprite uses
+	const auto& rect = sprite.getTextureRect();
+	const auto width = static_cast<float>(std::abs(rect.width));
+	const auto height = static_cast<float>(std::abs(rect.height));
+
+	const auto left = static_cast<float>(rect.left);
+	const auto right = left + rect.width;
+	const auto top = static_cast<float>(rect.top);
+	const auto bottom = top + rect.height;
+
+	const auto combined = transform * sprite.getTransform();
+	const auto color = sprite.getColor();
+
+	mVertices.append(sf::Vertex(combined.transformPoint(0.f, 0.f), color, { left, top }));
+	mVertices.append(sf::Vertex(combined.transformPoint(width, 0.f), color, { right, top }));
+	mVertices.append(sf::Vertex(combined.transformPoint(width, height), color, { right, bottom }));
+	mVertices.append(sf::Vertex(combined.transformPoint(0.f, height), color, { left, bottom }));
+}
+
+void SpriteBatch::draw(const sf::VertexArray& quads, const sf::Texture* texture, const sf::Transform& transform)
+{
+	assert(quads.getPrimitiveType() == sf::Quads);
+
+	if (quads.getVertexCount() == 0)
+		return;
+
+	setTexture(texture);
+
+	for (auto i = 0u; i < quads.getVertexCount(); ++i)
+	{
+		auto vertex = quads[i];
+		vertex.position = transform.transformPoint(vertex.position);
+
+		mVertices.append(vertex);
+	}
+}
+
+void SpriteBatch::draw(const sf::Drawable& drawable, const sf::RenderStates& states)
+{
+	assert(mTarget);
+
+	flush();
+
+	mTarget->draw(drawable, states);
+	mDrawCalls++;
+}
+
+void SpriteBatch::drawRectangle(const sf::RectangleShape& shape, const sf::Transform& transform)
+{
+	const auto combined = transform * shape.getTransform();
+	const auto size = shape.getSize();
+	const auto thickness = shape.getOutlineThickness();
+
+	if (shape.getFillColor().a != 0)
+		appendQuad(combined, { 0.f, 0.f, size.x, size.y }, shape.getFillColor());
+
+	if (thickness == 0.f || shape.getOutlineColor().a == 0)
+		return;
+
+	// the outline grows outwards for a positive thickness and inwards for a negative one
+	const auto outerLeft = std::min(0.f, -thickness);
+	const auto outerRight = size.x + std::max(0.f, thickness);
+	const auto outerTop = outerLeft;
+	const auto outerBottom = size.y + std::max(0.f, thickness);
+	const auto innerLeft = std::max(0.f, -thickness);
+	const auto innerRight = size.x + std::min(0.f, thickness);
+	const auto innerTop = innerLeft;
+	const auto innerBottom = size.y + std::min(0.f, thickness);
+
+	const auto color = shape.getOutlineColor();
+	appendQuad(combined, { outerLeft, outerTop, outerRight - outerLeft, innerTop - outerTop }, color);
+	appendQuad(combined, { outerLeft, innerBottom, outerRight - outerLeft, outerBottom - innerBottom }, color);
+	appendQuad(combined, { outerLeft, innerTop, innerLeft - outerLeft, innerBottom - innerTop }, color);
+	appendQuad(combined, { innerRight, innerTop, outerRight - innerRight, innerBottom - innerTop }, color);
+}
+
+void SpriteBatch::flush()
+{
+	if (mVertices.getVertexCount() == 0)
+		return;
+
+	assert(mTarget);
+
+	sf::RenderStates states;
+	states.texture = mTexture;
+
+	mTarget->draw(mVertices, states);
+	mDrawCalls++;
+
+	mVertices.clear();
+}
+
+std::size_t SpriteBatch::getDrawCallCount() const
+{
+	return mDrawCalls;
+}
+
+void SpriteBatch::appendQuad(const sf::Transform& transform, sf::FloatRect rect, sf::Color color)
+{
+	mRectangles.append(sf::Vertex(transform.transformPoint(rect.left, rect.top), color));
+	mRectangles.append(sf::Vertex(transform.transformPoint(rect.left + rect.width, rect.top), color));
+	mRectangles.append(sf::Vertex(transform.transformPoint(rect.left + rect.width, rect.top + rect.height), color));
+	mRectangles.append(sf::Vertex(transform.transformPoint(rect.left, rect.top + rect.height), color));
+}
+
+void SpriteBatch::setTexture(const sf::Texture* texture)
+{
+	if (texture != mTexture)
+	{
+		flush();
+		mTexture = texture;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+	class RenderTarget;
+	class Sprite;
+	class RectangleShape;
+}
+
+// Collects textured quads and submits them in one draw call per run of the same
+// texture. Anything it can't batch flushes the pending quads first, so the
+// result is drawn in the same order as drawing everything directly.
+// Rectangle outlines are collected apart and drawn once on top at end().
+class SpriteBatch final : private sf::NonCopyable
+{
+public:
+	SpriteBatch();
+
+	void begin(sf::RenderTarget& target);
+	void end();
+
+	void draw(const sf::Sprite& sprite, const sf::Transform& transform);
+	void draw(const sf::VertexArray& quads, const sf::Texture* texture, const sf::Transform& transform);
+	void draw(const sf::Drawable& drawable, const sf::RenderStates& states);
+	// fill and outline of an axis aligned shape as untextured quads, debug overlays
+	void drawRectangle(const sf::RectangleShape& shape, const sf::Transform& transform);
+
+	void flush();
+
+	// draw calls submitted since begin()
+	std::size_t getDrawCallCount() const;
+
+
+private:
+	void setTexture(const sf::Texture* texture);
+	void appendQuad(const sf::Transform& transform, sf::FloatRect rect, sf::Color color);
+
+
+private:
+	sf::RenderTarget* mTarget;
+	sf::VertexArray mVertices;
+	sf::VertexArray mRectangles;
+	const sf::Texture* mTexture;
+	std::size_t mDrawCalls;
+};
@@ -0,0 +1,198 @@
+#include "StaticBodyIndex.hpp"
+#include "SceneNode.hpp"
+#include "TerrainGrid.hpp"
+
+#include <cassert>
+
+
+StaticBodyIndex::StaticBodyIndex()
+	: mTerrain(nullptr)
+	, mBodies()
+	, mBounds()
+	, mSensors()
+	, mBodyGrid(16.f)
+	, mSensorGrid(16.f)
+	, mStaticContacts()
+	, mContacts()
+	, mTouched()
+	, mPreviousTouched()
+	, mCandidates()
+	, mFreeIds()
+	, mBodyCount(0u)
+	, mNeedsContactUpdate(true)
+{
+}
+
+void StaticBodyIndex::reset(const sf::FloatRect& worldBounds, const TerrainGrid& terrain)
+{
+	mTerrain = &terrain;
+	mBodies.clear();
+	mBounds.clear();
+	mSensors.clear();
+	mStaticContacts.clear();
+	mContacts.clear();
+	mTouched.clear();
+	mPreviousTouched.clear();
+	mFreeIds.clear();
+	mBodyCount = 0u;
+
+	mBodyGrid.reset(worldBounds);
+	mSensorGrid.reset(worldBounds);
+
+	mNeedsContactUpdate = true;
+}
+
+std::size_t StaticBodyIndex::insert(SceneNode& body)
+{
+	auto id = mBodies.size();
+
+	if (mFreeIds.empty())
+	{
+		mBodies.emplace_back(&body);
+		mBounds.push(body.getBoundingRect());
+		mSensors.push(body.getFootSensorBoundingRect());
+		mStaticContacts.emplace_back(0u);
+		mContacts.emplace_back(0u);
+	}
+	else
+	{
+		// a contact count left in the slot is cleared with this tick's touched list
+		id = mFreeIds.back();
+		mFreeIds.pop_back();
+
+		mBodies[id] = &body;
+		mBounds.set(id, body.getBoundingRect());
+		mSensors.set(id, body.getFootSensorBoundingRect());
+	}
+
+	mBodyCount++;
+
+	mBodyGrid.insert(id, mBounds.get(id));
+	mSensorGrid.insert(id, mSensors.get(id));
+
+	mNeedsContactUpdate = true;
+
+	return id;
+}
+
+void StaticBodyIndex::update(std::size_t id)
+{
+	assert(id < mBodies.size());
+
+	auto* body = mBodies[id];
+	if (!body) return;
+
+	// grid cells always come from the stored rects so remove matches insert
+	mBodyGrid.remove(id, mBounds.get(id));
+	mSensorGrid.remove(id, mSensors.get(id));
+
+	mNeedsContactUpdate = true;
+
+	if (body->isDestroyed())
+	{
+		mBodies[id] = nullptr;
+		mFreeIds.emplace_back(id);
+		mBodyCount--;
+		return;
+	}
+
+	mBounds.set(id, body->getBoundingRect());
+	mSensors.set(id, body->getFootSensorBoundingRect());
+
+	mBodyGrid.insert(id, mBounds.get(id));
+	mSensorGrid.insert(id, mSensors.get(id));
+}
+
+SceneNode* StaticBodyIndex::get(std::size_t id) const
+{
+	return mBodies[id];
+}
+
+std::size_t StaticBodyIndex::getBodyCount() const
+{
+	return mBodyCount;
+}
+
+const RectArray& StaticBodyIndex::getBoundingRects() const
+{
+	return mBounds;
+}
+
+const RectArray& StaticBodyIndex::getFootSensorBoundingRects() const
+{
+	return mSensors;
+}
+
+void StaticBodyIndex::queryBodies(const sf::FloatRect& area, std::vector<std::size_t>& result) const
+{
+	mBodyGrid.query(area, result);
+}
+
+void StaticBodyIndex::querySensors(const sf::FloatRect& area, std::vector<std::size_t>& result) const
+{
+	mSensorGrid.query(area, result);
+}
+
+void StaticBodyIndex::clearContacts()
+{
+	for (auto id : mTouched)
+		mContacts[id] = 0u;
+
+	mPreviousTouched.swap(mTouched);
+	mTouched.clear();
+}
+
+void StaticBodyIndex::addContact(std::size_t id)
+{
+	if (mContacts[id]++ == 0u)
+		mTouched.emplace_back(id);
+}
+
+void StaticBodyIndex::applyFootSenseCounts()
+{
+	auto apply = [this](std::size_t id)
+	{
+		if (mBodies[id])
+			mBodies[id]->setFootSenseCount(mStaticContacts[id] + mContacts[id]);
+	};
+
+	if (mNeedsContactUpdate)
+	{
+		updateStaticContacts();
+		mNeedsContactUpdate = false;
+
+		for (auto id = 0u; id < mBodies.size(); ++id)
+			apply(id);
+
+		return;
+	}
+
+	// only bodies touched by a dynamic body this tick or the last one can differ
+	for (auto id : mPreviousTouched)
+		apply(id);
+
+	for (auto id : mTouched)
+		apply(id);
+}
+
+void StaticBodyIndex::updateStaticContacts()
+{
+	for (auto id = 0u; id < mBodies.size(); ++id)
+	{
+		mStaticContacts[id] = 0u;
+
+		if (!mBodies[id]) continue;
+
+		if (mTerrain && mTerrain->intersects(mSensors.get(id)))
+			mStaticContacts[id]++;
+
+		mBodyGrid.query(mSensors.get(id), mCandidates);
+		for (auto other : mCandidates)
+		{
+			if (other == id) continue;
+
+			if (mSensors.intersects(id, mBounds, other))
+				mStaticContacts[id]++;
+		}
+	}
+}
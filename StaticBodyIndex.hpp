@@ -0,0 +1,66 @@
+#pragma once
+
+#include "SpatialGrid.hpp"
+#include "RectArray.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+#include <vector>
+
+
+class SceneNode;
+class TerrainGrid;
+
+
+// Persistent collision index for level geometry (bricks, boxes).
+// Bounds are cached and only refetched when a body reports a change through
+// update(), destroyed bodies leave an empty slot so ids stay stable until a
+// later insert takes the slot over, streamed levels keep adding tiles.
+class StaticBodyIndex final : private sf::NonCopyable
+{
+public:
+	StaticBodyIndex();
+
+	// terrain counts as a static contact for the foot sensors, it never changes after load
+	void reset(const sf::FloatRect& worldBounds, const TerrainGrid& terrain);
+
+	std::size_t insert(SceneNode& body);
+	void update(std::size_t id);
+
+	SceneNode* get(std::size_t id) const;
+	std::size_t getBodyCount() const;
+	const RectArray& getBoundingRects() const;
+	const RectArray& getFootSensorBoundingRects() const;
+
+	void queryBodies(const sf::FloatRect& area, std::vector<std::size_t>& result) const;
+	void querySensors(const sf::FloatRect& area, std::vector<std::size_t>& result) const;
+
+	// Foot sensor contacts from dynamic bodies are counted every tick,
+	// contacts between static bodies are cached until one of them changes
+	void clearContacts();
+	void addContact(std::size_t id);
+	void applyFootSenseCounts();
+
+
+private:
+	void updateStaticContacts();
+
+
+private:
+	const TerrainGrid* mTerrain;
+	std::vector<SceneNode*> mBodies;
+	RectArray mBounds;
+	RectArray mSensors;
+	SpatialGrid mBodyGrid;
+	SpatialGrid mSensorGrid;
+
+	std::vector<unsigned int> mStaticContacts;
+	std::vector<unsigned int> mContacts;
+	std::vector<std::size_t> mTouched;
+	std::vector<std::size_t> mPreviousTouched;
+	std::vector<std::size_t> mCandidates;
+	std::vector<std::size_t> mFreeIds;
+	std::size_t mBodyCount;
+	bool mNeedsContactUpdate;
+};
@@ -0,0 +1,247 @@
+#include "SweepAndPrune.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace
+{
+	std::uint32_t getSlot(std::uint32_t data)
+	{
+		return data >> 2;
+	}
+
+	unsigned int getKind(std::uint32_t data)
+	{
+		return (data >> 1) & 1u;
+	}
+
+	bool isMax(std::uint32_t data)
+	{
+		return (data & 1u) != 0u;
+	}
+
+	std::uint64_t makeKey(std::uint32_t a, std::uint32_t b)
+	{
+		if (a > b) std::swap(a, b);
+		return (static_cast<std::uint64_t>(a) << 32) | b;
+	}
+}
+
+SweepAndPrune::SweepAndPrune()
+	: mSlots()
+	, mFreeSlots()
+	, mLookup()
+	, mAdded()
+	, mEndpoints()
+	, mActive()
+	, mPairs()
+	, mPreviousPairs()
+	, mContacts()
+	, mSensorCounts()
+	, mStamp(0u)
+{
+}
+
+void SweepAndPrune::update(const std::vector<SceneNode*>& bodies, const RectArray& bounds, const RectArray& sensors)
+{
+	assert(bounds.size() == bodies.size() && sensors.size() == bodies.size());
+
+	synchronise(bodies);
+	sort(bounds, sensors);
+	sweep(bounds, sensors);
+	diff();
+	release();
+}
+
+const std::vector<SweepAndPrune::Contact>& SweepAndPrune::getContacts() const
+{
+	return mContacts;
+}
+
+unsigned int SweepAndPrune::getSensorCount(std::size_t body) const
+{
+	return mSensorCounts[body];
+}
+
+void SweepAndPrune::synchronise(const std::vector<SceneNode*>& bodies)
+{
+	++mStamp;
+	mAdded.clear();
+
+	for (auto i = std::size_t(0u); i < bodies.size(); ++i)
+	{
+		auto* body = bodies[i];
+
+		auto found = std::lower_bound(mLookup.begin(), mLookup.end(), std::make_pair(body, std::uint32_t(0u)));
+		auto slot = std::uint32_t(0u);
+
+		if (found != mLookup.end() && found->first == body)
+		{
+			slot = found->second;
+		}
+		else
+		{
+			if (mFreeSlots.empty())
+			{
+				slot = static_cast<std::uint32_t>(mSlots.size());
+				mSlots.push_back({ nullptr, 0u, 0u });
+			}
+			else
+			{
+				slot = mFreeSlots.back();
+				mFreeSlots.pop_back();
+			}
+
+			mSlots[slot].owner = body;
+			mAdded.emplace_back(body, slot);
+
+			// appended at the back, the next sort moves them into place
+			for (auto kind : { Bounds, Sensor })
+			{
+				mEndpoints.push_back({ 0.f, slot << 2 | kind << 1 });
+				mEndpoints.push_back({ 0.f, slot << 2 | kind << 1 | 1u });
+			}
+		}
+
+		mSlots[slot].body = i;
+		mSlots[slot].stamp = mStamp;
+	}
+
+	if (!mAdded.empty())
+	{
+		mLookup.insert(mLookup.end(), mAdded.begin(), mAdded.end());
+		std::sort(mLookup.begin(), mLookup.end());
+	}
+
+	// bodies not seen this tick leave the sweep, their slots are freed after the diff
+	mEndpoints.erase(std::remove_if(mEndpoints.begin(), mEndpoints.end(), [this](const Endpoint& endpoint)
+	{
+		return mSlots[getSlot(endpoint.data)].stamp != mStamp;
+	}), mEndpoints.end());
+}
+
+void SweepAndPrune::sort(const RectArray& bounds, const RectArray& sensors)
+{
+	for (auto& endpoint : mEndpoints)
+	{
+		const auto body = mSlots[getSlot(endpoint.data)].body;
+		const auto& rects = (getKind(endpoint.data) == Bounds) ? bounds : sensors;
+
+		endpoint.value = isMax(endpoint.data) ? rects.getRight(body) : rects.getLeft(body);
+	}
+
+	// insertion sort, nearly sorted from the last tick
+	for (auto i = std::size_t(1u); i < mEndpoints.size(); ++i)
+	{
+		const auto endpoint = mEndpoints[i];
+
+		auto j = i;
+		for (; j > 0u && mEndpoints[j - 1u].value > endpoint.value; --j)
+			mEndpoints[j] = mEndpoints[j - 1u];
+
+		mEndpoints[j] = endpoint;
+	}
+}
+
+void SweepAndPrune::sweep(const RectArray& bounds, const RectArray& sensors)
+{
+	mActive.clear();
+	mPairs.clear();
+	mSensorCounts.assign(bounds.size(), 0u);
+
+	for (const auto& endpoint : mEndpoints)
+	{
+		const auto proxy = endpoint.data >> 1;
+
+		if (isMax(endpoint.data))
+		{
+			auto found = std::find(mActive.begin(), mActive.end(), proxy);
+			assert(found != mActive.end());
+
+			*found = mActive.back();
+			mActive.pop_back();
+		}
+		else
+		{
+			for (auto other : mActive)
+				report(proxy, other, bounds, sensors);
+
+			mActive.push_back(proxy);
+		}
+	}
+
+	std::sort(mPairs.begin(), mPairs.end());
+}
+
+void SweepAndPrune::report(std::uint32_t a, std::uint32_t b, const RectArray& bounds, const RectArray& sensors)
+{
+	// proxies are slot << 1 | kind
+	const auto slotA = a >> 1;
+	const auto slotB = b >> 1;
+	if (slotA == slotB) return;
+
+	const auto kindA = a & 1u;
+	const auto kindB = b & 1u;
+	const auto bodyA = mSlots[slotA].body;
+	const auto bodyB = mSlots[slotB].body;
+
+	if (kindA == Bounds && kindB == Bounds)
+	{
+		if (bounds.intersects(bodyA, bounds, bodyB))
+			mPairs.push_back(makeKey(slotA, slotB));
+	}
+	else if (kindA == Sensor && kindB == Bounds)
+	{
+		if (sensors.intersects(bodyA, bounds, bodyB))
+			mSensorCounts[bodyA]++;
+	}
+	else if (kindA == Bounds && kindB == Sensor)
+	{
+		if (sensors.intersects(bodyB, bounds, bodyA))
+			mSensorCounts[bodyB]++;
+	}
+}
+
+void SweepAndPrune::diff()
+{
+	mContacts.clear();
+
+	auto contact = [this](std::uint64_t key, Event event)
+	{
+		const auto first = static_cast<std::uint32_t>(key >> 32);
+		const auto second = static_cast<std::uint32_t>(key);
+		mContacts.push_back({ mSlots[first].owner, mSlots[second].owner, event });
+	};
+
+	auto current = mPairs.cbegin();
+	auto previous = mPreviousPairs.cbegin();
+
+	while (current != mPairs.cend() || previous != mPreviousPairs.cend())
+	{
+		if (previous == mPreviousPairs.cend() || (current != mPairs.cend() && *current < *previous))
+			contact(*current++, Begin);
+		else if (current == mPairs.cend() || *previous < *current)
+			contact(*previous++, End);
+		else
+		{
+			contact(*current++, Stay);
+			++previous;
+		}
+	}
+
+	mPreviousPairs.swap(mPairs);
+}
+
+void SweepAndPrune::release()
+{
+	mLookup.erase(std::remove_if(mLookup.begin(), mLookup.end(), [this](const auto& entry)
+	{
+		auto& slot = mSlots[entry.second];
+		if (slot.stamp == mStamp) return false;
+
+		slot.owner = nullptr;
+		mFreeSlots.push_back(entry.second);
+		return true;
+	}), mLookup.end());
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "RectArray.hpp"
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <cstdint>
+#include <vector>
+
+
+class SceneNode;
+
+
+// Sweep and prune broadphase on the X axis for moving bodies. Each body keeps
+// a slot across ticks, found by its address, with two proxies: its bounds and
+// its foot sensor. The endpoint list stays sorted between ticks and is fixed up
+// by insertion sort, so coherent motion costs about one pass. Overlapping body
+// pairs are diffed against the last tick into begin, stay and end contacts.
+class SweepAndPrune final : private sf::NonCopyable
+{
+public:
+	enum Event
+	{
+		Begin,
+		Stay,
+		End
+	};
+
+	struct Contact
+	{
+		SceneNode* first;
+		SceneNode* second;
+		Event event;
+	};
+
+
+private:
+	enum Kind
+	{
+		Bounds,
+		Sensor
+	};
+
+	struct Slot
+	{
+		SceneNode* owner;
+		std::size_t body;
+		unsigned int stamp;
+	};
+
+	// data packs slot << 2 | kind << 1 | isMax
+	struct Endpoint
+	{
+		float value;
+		std::uint32_t data;
+	};
+
+
+public:
+	SweepAndPrune();
+
+	// bodies[i] owns bounds[i] and sensors[i]
+	void update(const std::vector<SceneNode*>& bodies, const RectArray& bounds, const RectArray& sensors);
+
+	// ordered by slot pair; the bodies of End contacts may be gone, don't touch them
+	const std::vector<Contact>& getContacts() const;
+	// other bodies whose bounds overlap the foot sensor of bodies[i]
+	unsigned int getSensorCount(std::size_t body) const;
+
+
+private:
+	void synchronise(const std::vector<SceneNode*>& bodies);
+	void sort(const RectArray& bounds, const RectArray& sensors);
+	void sweep(const RectArray& bounds, const RectArray& sensors);
+	void report(std::uint32_t a, std::uint32_t b, const RectArray& bounds, const RectArray& sensors);
+	void diff();
+	void release();
+
+
+private:
+	std::vector<Slot> mSlots;
+	std::vector<std::uint32_t> mFreeSlots;
+	std::vector<std::pair<SceneNode*, std::uint32_t>> mLookup; // sorted by address
+	std::vector<std::pair<SceneNode*, std::uint32_t>> mAdded;
+	std::vector<Endpoint> mEndpoints;
+	std::vector<std::uint32_t> mActive;
+	std::vector<std::uint64_t> mPairs;
+	std::vector<std::uint64_t> mPreviousPairs;
+	std::vector<Contact> mContacts;
+	std::vector<unsigned int> mSensorCounts;
+	unsigned int mStamp;
+};
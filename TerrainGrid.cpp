@@ -0,0 +1,163 @@
+#include "TerrainGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+TerrainGrid::Proxy::Proxy()
+	: SceneNode(Category::Block)
+	, mBounds()
+{
+}
+
+void TerrainGrid::Proxy::setBounds(const sf::FloatRect& bounds)
+{
+	mBounds = bounds;
+	setPosition(bounds.left + bounds.width / 2.f, bounds.top + bounds.height / 2.f);
+}
+
+sf::FloatRect TerrainGrid::Proxy::getBoundingRect() const
+{
+	return mBounds;
+}
+
+TerrainGrid::TerrainGrid(float cellSize)
+	: mCellSize(cellSize)
+	, mOrigin()
+	, mColumns(0)
+	, mRows(0)
+	, mWordsPerRow(0)
+	, mBits()
+	, mSolidCount(0u)
+{
+}
+
+void TerrainGrid::reset(const sf::FloatRect& bounds)
+{
+	mOrigin = { bounds.left, bounds.top };
+	mColumns = std::max(0, static_cast<int>(std::ceil(bounds.width / mCellSize)));
+	mRows = std::max(0, static_cast<int>(std::ceil(bounds.height / mCellSize)));
+	mWordsPerRow = (mColumns + 31) / 32;
+
+	mBits.assign(static_cast<std::size_t>(mWordsPerRow * mRows), 0u);
+	mSolidCount = 0u;
+}
+
+void TerrainGrid::fill(const sf::FloatRect& area)
+{
+	auto snap = [this](float value, int count)
+	{
+		return std::max(0, std::min(count, static_cast<int>(std::round(value / mCellSize))));
+	};
+
+	const auto left = snap(area.left - mOrigin.x, mColumns);
+	const auto right = snap(area.left + area.width - mOrigin.x, mColumns);
+	const auto top = snap(area.top - mOrigin.y, mRows);
+	const auto bottom = snap(area.top + area.height - mOrigin.y, mRows);
+
+	for (auto y = top; y < bottom; ++y)
+	{
+		for (auto x = left; x < right; ++x)
+		{
+			auto& word = mBits[y * mWordsPerRow + x / 32];
+			const auto bit = std::uint32_t(1u) << (x % 32);
+
+			if (!(word & bit))
+				mSolidCount++;
+
+			word |= bit;
+		}
+	}
+}
+
+bool TerrainGrid::isSolid(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= mColumns || y >= mRows)
+		return false;
+
+	return (mBits[y * mWordsPerRow + x / 32] >> (x % 32)) & 1u;
+}
+
+bool TerrainGrid::intersects(const sf::FloatRect& area) const
+{
+	CellRange range;
+	if (!getCellRange(area, range)) return false;
+
+	for (auto y = range.top; y <= range.bottom; ++y)
+	{
+		for (auto x = range.left; x <= range.right; ++x)
+		{
+			if (isSolid(x, y))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+void TerrainGrid::query(const sf::FloatRect& area, std::vector<sf::FloatRect>& result) const
+{
+	result.clear();
+
+	CellRange range;
+	if (!getCellRange(area, range)) return;
+
+	// rects started or grown on the row above, the only ones a run may extend
+	auto previousBegin = std::size_t(0u);
+	auto previousEnd = std::size_t(0u);
+
+	for (auto y = range.top; y <= range.bottom; ++y)
+	{
+		auto rowBegin = result.size();
+		const auto top = mOrigin.y + y * mCellSize;
+
+		for (auto x = range.left; x <= range.right; ++x)
+		{
+			if (!isSolid(x, y)) continue;
+
+			const auto first = x;
+			while (x + 1 <= range.right && isSolid(x + 1, y))
+				++x;
+
+			const auto left = mOrigin.x + first * mCellSize;
+			const auto width = (x - first + 1) * mCellSize;
+
+			auto merged = false;
+			for (auto i = previousBegin; i < previousEnd; ++i)
+			{
+				auto& rect = result[i];
+				if (rect.left == left && rect.width == width)
+				{
+					rect.height += mCellSize;
+					// move it from the row above into this row, the next row may keep growing it
+					std::swap(rect, result[--previousEnd]);
+					rowBegin = previousEnd;
+					merged = true;
+					break;
+				}
+			}
+
+			if (!merged)
+				result.emplace_back(left, top, width, mCellSize);
+		}
+
+		previousBegin = rowBegin;
+		previousEnd = result.size();
+	}
+}
+
+std::size_t TerrainGrid::getSolidCount() const
+{
+	return mSolidCount;
+}
+
+bool TerrainGrid::getCellRange(const sf::FloatRect& area, CellRange& range) const
+{
+	// cells only touching an edge of area don't overlap it, like sf::Rect::intersects
+	range.left = std::max(0, static_cast<int>(std::floor((area.left - mOrigin.x) / mCellSize)));
+	range.top = std::max(0, static_cast<int>(std::floor((area.top - mOrigin.y) / mCellSize)));
+	range.right = std::min(mColumns - 1, static_cast<int>(std::ceil((area.left + area.width - mOrigin.x) / mCellSize)) - 1);
+	range.bottom = std::min(mRows - 1, static_cast<int>(std::ceil((area.top + area.height - mOrigin.y) / mCellSize)) - 1);
+
+	return range.left <= range.right && range.top <= range.bottom;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "SceneNode.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+#include <cstdint>
+#include <vector>
+
+
+// Collision layer for level terrain, one bit per square cell, filled from the
+// block objects of the map at load. Moving bodies look up the cells around
+// their bounds instead of testing against block entities, so the cost per body
+// doesn't depend on the level length. Anything outside the grid is empty.
+class TerrainGrid final : private sf::NonCopyable
+{
+public:
+	// stands in for the terrain on the other side of a collision,
+	// reports Category::Block like the block tiles it replaces
+	class Proxy final : public SceneNode
+	{
+	public:
+		Proxy();
+
+		void setBounds(const sf::FloatRect& bounds);
+		sf::FloatRect getBoundingRect() const override;
+
+
+	private:
+		sf::FloatRect mBounds;
+	};
+
+
+private:
+	struct CellRange
+	{
+		int left;
+		int top;
+		int right;
+		int bottom;
+	};
+
+
+public:
+	explicit TerrainGrid(float cellSize = 16.f);
+
+	void reset(const sf::FloatRect& bounds);
+	// marks every cell whose center lies inside area, so rects a pixel off the grid snap to it
+	void fill(const sf::FloatRect& area);
+
+	bool isSolid(int x, int y) const;
+	bool intersects(const sf::FloatRect& area) const;
+
+	// Solid cells sharing space with area, merged into row runs and then into
+	// rects of stacked runs with the same span, so floors and walls come back whole
+	void query(const sf::FloatRect& area, std::vector<sf::FloatRect>& result) const;
+
+	std::size_t getSolidCount() const;
+
+
+private:
+	bool getCellRange(const sf::FloatRect& area, CellRange& range) const;
+
+
+private:
+	float mCellSize;
+	sf::Vector2f mOrigin;
+	int mColumns;
+	int mRows;
+	int mWordsPerRow;
+	std::vector<std::uint32_t> mBits;
+	std::size_t mSolidCount;
+};
@@ -0,0 +1,117 @@
+#include "TextureAtlas.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+
+TextureAtlas::TextureAtlas()
+	: mImages()
+	, mRegions()
+	, mTexture()
+{
+}
+
+void TextureAtlas::load(Textures::ID id, const std::string& filename)
+{
+	sf::Image image;
+	if (!image.loadFromFile(filename))
+		throw std::runtime_error("TextureAtlas::load - Failed to load " + filename);
+
+	insert(id, image);
+}
+
+void TextureAtlas::insert(Textures::ID id, const sf::Image& image)
+{
+	auto inserted(mImages.emplace(id, image));
+	assert(inserted.second);
+}
+
+void TextureAtlas::build(bool createTexture)
+{
+	std::vector<Textures::ID> order;
+	auto widest = 1u;
+	auto area = 0u;
+
+	for (const auto& pair : mImages)
+	{
+		const auto size = pair.second.getSize();
+
+		order.push_back(pair.first);
+		widest = std::max(widest, size.x + Padding);
+		area += (size.x + Padding) * (size.y + Padding);
+	}
+
+	// shelves of sheets, tallest first
+	std::sort(order.begin(), order.end(), [this](auto lhs, auto rhs)
+	{
+		return mImages.at(lhs).getSize().y > mImages.at(rhs).getSize().y;
+	});
+
+	auto width = 1u;
+	while (width < std::max(widest, static_cast<unsigned int>(std::sqrt(static_cast<float>(area)))))
+		width <<= 1;
+
+	auto x = 0u, y = 0u, shelfHeight = 0u;
+
+	for (auto id : order)
+	{
+		const auto size = mImages.at(id).getSize();
+
+		if (x + size.x > width)
+		{
+			x = 0u;
+			y += shelfHeight;
+			shelfHeight = 0u;
+		}
+
+		mRegions[id] = sf::IntRect(x, y, size.x, size.y);
+
+		x += size.x + Padding;
+		shelfHeight = std::max(shelfHeight, size.y + Padding);
+	}
+
+	const auto height = y + shelfHeight;
+
+	if (createTexture)
+	{
+		if (width > sf::Texture::getMaximumSize() || height > sf::Texture::getMaximumSize())
+			throw std::runtime_error("TextureAtlas::build - Sheets do not fit in one texture");
+
+		sf::Image atlas;
+		atlas.create(width, std::max(height, 1u), sf::Color::Transparent);
+
+		for (const auto& pair : mRegions)
+			atlas.copy(mImages.at(pair.first), pair.second.left, pair.second.top);
+
+		mTexture = std::make_unique<sf::Texture>();
+		if (!mTexture->loadFromImage(atlas))
+			throw std::runtime_error("TextureAtlas::build - Failed to create texture");
+	}
+
+	mImages.clear();
+}
+
+const sf::Texture* TextureAtlas::get(Textures::ID id) const
+{
+	assert(mRegions.find(id) != mRegions.end());
+
+	return mTexture.get();
+}
+
+sf::IntRect TextureAtlas::getRegion(Textures::ID id) const
+{
+	auto found(mRegions.find(id));
+	assert(found != mRegions.end());
+
+	return found->second;
+}
+
+sf::IntRect TextureAtlas::map(Textures::ID id, const sf::IntRect& rect) const
+{
+	const auto region = getRegion(id);
+
+	return{ rect.left + region.left, rect.top + region.top, rect.width, rect.height };
+}
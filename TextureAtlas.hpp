@@ -0,0 +1,46 @@
+#pragma once
+
+
+#include "ResourceIdentifiers.hpp"
+
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+
+
+// Packs every sprite sheet into one texture, so all sprites share it.
+// Sheets are packed whole because animations step through neighbouring
+// frames in sheet coordinates, getRegion() tells where each one ended up.
+class TextureAtlas final : private sf::NonCopyable
+{
+public:
+	TextureAtlas();
+
+	void load(Textures::ID id, const std::string& filename);
+	void insert(Textures::ID id, const sf::Image& image);
+
+	// places the sheets and uploads the texture, without texture only the regions are computed
+	// and no GL resource is ever created, so headless runs need no display
+	void build(bool createTexture = true);
+
+	// the shared atlas texture, same for every id, null if built without texture
+	const sf::Texture* get(Textures::ID id) const;
+	sf::IntRect getRegion(Textures::ID id) const;
+	// rect in the sheet of id to rect in the atlas
+	sf::IntRect map(Textures::ID id, const sf::IntRect& rect) const;
+
+
+private:
+	static const unsigned int Padding = 1u;
+
+
+private:
+	std::map<Textures::ID, sf::Image> mImages;
+	std::map<Textures::ID, sf::IntRect> mRegions;
+	std::unique_ptr<sf::Texture> mTexture;
+};
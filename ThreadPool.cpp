@@ -0,0 +1,127 @@
+#include "ThreadPool.hpp"
+
+
+ThreadPool::ThreadPool(std::size_t workers)
+	: mWorkers()
+	, mMutex()
+	, mWakeUp()
+	, mDone()
+	, mTask()
+	, mCount(0u)
+	, mNext(0u)
+	, mPending(0u)
+	, mBusy(0u)
+	, mGeneration(0u)
+	, mStopping(false)
+{
+	mWorkers.reserve(workers);
+
+	for (auto i = 0u; i < workers; ++i)
+		mWorkers.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	wait();
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopping = true;
+	}
+
+	mWakeUp.notify_all();
+
+	for (auto& worker : mWorkers)
+		worker.join();
+}
+
+void ThreadPool::dispatch(std::size_t count, Task task)
+{
+	wait();
+
+	if (count == 0u)
+		return;
+
+	if (mWorkers.empty())
+	{
+		for (auto i = std::size_t(0u); i < count; ++i)
+			task(i);
+
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mTask = std::move(task);
+		mCount = count;
+		mNext = 0u;
+		mPending = count;
+		mGeneration++;
+	}
+
+	mWakeUp.notify_all();
+}
+
+void ThreadPool::wait()
+{
+	runTasks();
+
+	std::unique_lock<std::mutex> lock(mMutex);
+	mDone.wait(lock, [this] { return mPending == 0u && mBusy == 0u; });
+}
+
+std::size_t ThreadPool::getWorkerCount() const
+{
+	return mWorkers.size();
+}
+
+std::size_t ThreadPool::defaultWorkerCount()
+{
+	// leave a core for the game thread
+	const auto cores = std::thread::hardware_concurrency();
+
+	return cores > 1u ? cores - 1u : 0u;
+}
+
+void ThreadPool::work()
+{
+	auto generation = std::size_t(0u);
+
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWakeUp.wait(lock, [&] { return mStopping || mGeneration != generation; });
+
+			if (mStopping)
+				return;
+
+			generation = mGeneration;
+
+			// woke up after the batch was already finished by others
+			if (mPending == 0u)
+				continue;
+
+			mBusy++;
+		}
+
+		runTasks();
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mBusy--;
+		}
+
+		mDone.notify_all();
+	}
+}
+
+void ThreadPool::runTasks()
+{
+	for (auto i = mNext++; i < mCount; i = mNext++)
+	{
+		mTask(i);
+		mPending--;
+	}
+}
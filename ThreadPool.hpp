@@ -0,0 +1,53 @@
+#pragma once
+
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Fixed set of worker threads running one batch of indexed tasks at a time.
+// The calling thread helps out while it waits, so no workers means inline.
+class ThreadPool final : private sf::NonCopyable
+{
+public:
+	using Task = std::function<void(std::size_t)>;
+
+
+public:
+	explicit ThreadPool(std::size_t workers = defaultWorkerCount());
+	~ThreadPool();
+
+	// runs task(i) for every i below count and returns at once,
+	// a batch still in flight is finished first
+	void dispatch(std::size_t count, Task task);
+	void wait();
+
+	std::size_t getWorkerCount() const;
+
+	static std::size_t defaultWorkerCount();
+
+
+private:
+	void work();
+	void runTasks();
+
+
+private:
+	std::vector<std::thread> mWorkers;
+	std::mutex mMutex;
+	std::condition_variable mWakeUp;
+	std::condition_variable mDone;
+	Task mTask;
+	std::size_t mCount;
+	std::atomic<std::size_t> mNext;
+	std::atomic<std::size_t> mPending;
+	std::size_t mBusy;
+	std::size_t mGeneration;
+	bool mStopping;
+};
@@ -1,12 +1,14 @@
 #include "Tile.hpp"
 #include "DataTables.hpp"
-#include "ResourceHolder.hpp"
+#include "TextureAtlas.hpp"
 #include "ParticleNode.hpp"
 #include "CommandQueue.hpp"
 //#include "Item.hpp"
+#include "SpriteBatch.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <array>
+#include <cassert>
 #include <iostream>
 #define Debug
 
@@ -17,9 +19,10 @@ namespace
 	const static std::vector<TileData>& Table = data::initializeTileData();
 }
 
-Tile::Tile(Type type, const TextureHolder& textures, sf::Vector2f size)
-	: mType(type)
-	, mSprite(textures.get(Table[type].texture), Table[type].textureRect)
+Tile::Tile(Type type, const TextureHolder& textures, EntityStore& store, sf::Vector2f size)
+	: Entity(store)
+	, mType(type)
+	, mSprite(textures, Table[type].texture, Table[type].textureRect)
 	, mFootSenseCount()
 	, mIsMarkedForRemoval(false)
 	, mIsHitBySmallPlayer(false)
@@ -32,69 +35,40 @@ Tile::Tile(Type type, const TextureHolder& textures, sf::Vector2f size)
 	, mCoinsCount()
 	, mCommand()
 	, mIsFired(false)
-	, mCollisionDispatcher()
-	, mUpdater()
+	, mItems(nullptr)
+	, mUpdater(nullptr)
+	, mChangeCallback()
 {
 	switch (mType)
 	{
 	case Type::Brick:
-		mUpdater = std::bind(&Tile::brickUpdate, this, _1, _2);
+		mUpdater = &Tile::brickUpdate;
 		mSpawnedExplosion = false;
-		mCollisionDispatcher.insert({
-			{ Category::BigPlayer, std::bind(&Tile::brickBigPlayerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Tile::brickSmallPlayerCollision, this, _1, _2) },
-			{ Category::Goomba, std::bind(&Tile::enemyCollision, this, _1, _2) },
-		});
 		break;
 	case Type::CoinsBox:
-		mUpdater = std::bind(&Tile::boxUpdate, this, _1, _2);
+		mUpdater = &Tile::boxUpdate;
 		mCommand.category = Category::BackLayer;
-		mCommand.action = std::bind(&Tile::createItem, this, _1, std::cref(textures), Item::MoveableCoin);
-		mCollisionDispatcher.insert({
-			{ Category::BigPlayer, std::bind(&Tile::coinsBoxBigPlayerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Tile::coinsBoxSmallPlayerCollision, this, _1, _2) },
-			{ Category::Goomba, std::bind(&Tile::enemyCollision, this, _1, _2) },
-		});
+		mCommand.action = std::bind(&Tile::createItem, this, _1, Item::MoveableCoin);
 		break;
 	case Type::SoloCoinBox:
-		mUpdater = std::bind(&Tile::boxUpdate, this, _1, _2);
+		mUpdater = &Tile::boxUpdate;
 		mCommand.category = Category::BackLayer;
-		mCommand.action = std::bind(&Tile::createItem, this, _1, std::cref(textures), Item::MoveableCoin);
-		mCollisionDispatcher.insert({
-			{ Category::BigPlayer, std::bind(&Tile::boxBigPlayerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Tile::boxSmallPlayerCollision, this, _1, _2) },
-			{ Category::Goomba, std::bind(&Tile::enemyCollision, this, _1, _2) },
-		});
+		mCommand.action = std::bind(&Tile::createItem, this, _1, Item::MoveableCoin);
 	break;
 	case Type::TransformBox:
-		mUpdater = std::bind(&Tile::boxUpdate, this, _1, _2);
+		mUpdater = &Tile::boxUpdate;
 		mCommand.category = Category::BackLayer;
-		mCommand.action = std::bind(&Tile::createItem, this, _1, std::cref(textures), Item::Mushroom);
-		mCollisionDispatcher.insert({
-			{ Category::BigPlayer, std::bind(&Tile::boxBigPlayerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Tile::boxSmallPlayerCollision, this, _1, _2) },
-			{ Category::Goomba, std::bind(&Tile::enemyCollision, this, _1, _2) },
-		});
+		mCommand.action = std::bind(&Tile::createItem, this, _1, Item::Mushroom);
 	break;
 	case Type::FireBox:
-		mUpdater = std::bind(&Tile::boxUpdate, this, _1, _2);
+		mUpdater = &Tile::boxUpdate;
 		mCommand.category = Category::BackLayer;
-		mCommand.action = std::bind(&Tile::createItem, this, _1, std::cref(textures), Item::Flower);
-		mCollisionDispatcher.insert({
-			{ Category::BigPlayer, std::bind(&Tile::boxBigPlayerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Tile::boxSmallPlayerCollision, this, _1, _2) },
-			{ Category::Goomba, std::bind(&Tile::enemyCollision, this, _1, _2) },
-		});
+		mCommand.action = std::bind(&Tile::createItem, this, _1, Item::Flower);
 		break;
 	case Type::ShiftBox:
-		mUpdater = std::bind(&Tile::boxUpdate, this, _1, _2);
+		mUpdater = &Tile::boxUpdate;
 		mCommand.category = Category::BackLayer;
-		mCommand.action = std::bind(&Tile::createItem, this, _1, std::cref(textures), Item::Star);
-		mCollisionDispatcher.insert({
-			{ Category::BigPlayer, std::bind(&Tile::boxBigPlayerCollision, this, _1, _2) },
-			{ Category::SmallPlayer, std::bind(&Tile::boxSmallPlayerCollision, this, _1, _2) },
-			{ Category::Goomba, std::bind(&Tile::enemyCollision, this, _1, _2) },
-		});
+		mCommand.action = std::bind(&Tile::createItem, this, _1, Item::Star);
 		break;
 	default: break;
 	}
@@ -102,6 +76,33 @@ Tile::Tile(Type type, const TextureHolder& textures, sf::Vector2f size)
 	setup(size);
 }
 
+const Tile::Collisions& Tile::getCollisionTable()
+{
+	static const auto table = []()
+	{
+		Collisions table;
+
+		table.set(Type::Brick, Category::BigPlayer, &Tile::brickBigPlayerCollision);
+		table.set(Type::Brick, Category::SmallPlayer, &Tile::brickSmallPlayerCollision);
+
+		table.set(Type::CoinsBox, Category::BigPlayer, &Tile::coinsBoxBigPlayerCollision);
+		table.set(Type::CoinsBox, Category::SmallPlayer, &Tile::coinsBoxSmallPlayerCollision);
+
+		for (auto type : { Type::SoloCoinBox, Type::TransformBox, Type::FireBox, Type::ShiftBox })
+		{
+			table.set(type, Category::BigPlayer, &Tile::boxBigPlayerCollision);
+			table.set(type, Category::SmallPlayer, &Tile::boxSmallPlayerCollision);
+		}
+
+		for (auto type : { Type::Brick, Type::CoinsBox, Type::SoloCoinBox, Type::TransformBox, Type::FireBox, Type::ShiftBox })
+			table.set(type, Category::Goomba, &Tile::enemyCollision);
+
+		return table;
+	}();
+
+	return table;
+}
+
 void Tile::setup(sf::Vector2f size)
 {
 	if (mType != Type::Block)
@@ -128,6 +129,19 @@ void Tile::setup(sf::Vector2f size)
 		auto bounds = mFootShape.getLocalBounds();
 		mFootShape.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
 	}
+
+	// tiles only ever move, the outline is fixed from here on
+	updateColliders();
+}
+
+void Tile::updateColliders()
+{
+	const auto sensor = getTransform().transformRect(mFootShape.getGlobalBounds());
+
+	if (mType != Type::Block)
+		setColliders(getTransform().transformRect(mSprite.getGlobalBounds()), sensor);
+	else
+		setColliders(sensor, sensor);
 }
 
 void Tile::setCoinsCount(unsigned int count)
@@ -135,6 +149,40 @@ void Tile::setCoinsCount(unsigned int count)
 	mCoinsCount = count;
 }
 
+unsigned int Tile::getCoinsCount() const
+{
+	return mCoinsCount;
+}
+
+Tile::Type Tile::getType() const
+{
+	return mType;
+}
+
+void Tile::setItemPool(ObjectPool<Item>& items)
+{
+	mItems = &items;
+}
+
+void Tile::setChangeCallback(ChangeCallback callback)
+{
+	mChangeCallback = std::move(callback);
+}
+
+void Tile::notifyChange()
+{
+	if (mChangeCallback) mChangeCallback();
+}
+
+void Tile::remove()
+{
+	mSpawnedExplosion = true;
+	destroy();
+	notifyChange();
+	// the index may hand the slot to another tile, nothing more to report
+	mChangeCallback = nullptr;
+}
+
 unsigned int Tile::getCategory() const
 {
 	const static std::array<unsigned int, Type::TypeCount> category
@@ -152,17 +200,18 @@ unsigned int Tile::getCategory() const
 	return category[mType];
 }
 
-bool Tile::isMarkedForRemoval() const
+unsigned int Tile::getPossibleCategories() const
 {
-	return mIsMarkedForRemoval;
+	// boxes turn solid once emptied
+	if (mType == Type::Block || mType == Type::Brick)
+		return getCategory();
+
+	return getCategory() | Category::SolidBox;
 }
 
-sf::FloatRect Tile::getBoundingRect() const
+bool Tile::isMarkedForRemoval() const
 {
-	if(mType != Type::Block)
-		return getWorldTransform().transformRect(mSprite.getGlobalBounds());
-	else
-		return getWorldTransform().transformRect(mFootShape.getGlobalBounds());
+	return mIsMarkedForRemoval;
 }
 
 void Tile::brickUpdate(sf::Time dt, CommandQueue& commands)
@@ -172,6 +221,7 @@ void Tile::brickUpdate(sf::Time dt, CommandQueue& commands)
 	if (mTimer >= sf::seconds(0.25f) && mIsHitBySmallPlayer)
 	{
 		move(-mJump);
+		notifyChange();
 		mIsHitBySmallPlayer = false;
 	}
 
@@ -179,6 +229,7 @@ void Tile::brickUpdate(sf::Time dt, CommandQueue& commands)
 	{
 		move(-mJump);
 		destroy();
+		notifyChange();
 		mIsHitByBigPlayer = false;
 	}
 }
@@ -190,11 +241,11 @@ void Tile::boxUpdate(sf::Time dt, CommandQueue& commands)
 	if (mTimer >= sf::seconds(0.25f) && mIsHitBySmallPlayer)
 	{
 		move(-mJump);
+		notifyChange();
 		mIsHitBySmallPlayer = false;
 		if (mCoinsCount > 0) return;
 		mCanAnimate = false;
 		mSprite.setTextureRect(Table[mType].idleRect);
-		mCollisionDispatcher.clear();
 		mType = Type::SolidBox;
 	}
 
@@ -215,25 +266,20 @@ void Tile::updateCurrent(sf::Time dt, CommandQueue& commands)
 		return;
 	}
 
-	if (mUpdater) mUpdater(dt, commands);
+	if (mUpdater) (this->*mUpdater)(dt, commands);
 
 	updateAnimation(dt);
 }
 
-void Tile::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
+void Tile::drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const
 {
-	if(mType != Type::Block)
-		target.draw(mSprite, states);
+	if (mType != Type::Block)
+		batch.draw(mSprite, transform);
 #ifdef Debug
-	target.draw(mFootShape, states);
+	batch.drawRectangle(mFootShape, transform);
 #endif // Debug
 }
 
-sf::FloatRect Tile::getFootSensorBoundingRect() const
-{
-	return getWorldTransform().transformRect(mFootShape.getGlobalBounds());
-}
-
 void Tile::setFootSenseCount(unsigned int count)
 {
 	mFootSenseCount = count;
@@ -246,13 +292,7 @@ unsigned int Tile::getFootSenseCount() const
 
 void Tile::resolve(const sf::Vector3f& manifold, SceneNode* other)
 {
-	for (const auto& collider : mCollisionDispatcher)
-	{
-		if (collider.first & other->getCategory())
-		{
-			collider.second(manifold, other);
-		}
-	}
+	getCollisionTable().resolve(*this, mType, manifold, other);
 }
 
 void Tile::brickBigPlayerCollision(const sf::Vector3f& manifold, SceneNode* other)
@@ -264,10 +304,12 @@ void Tile::brickBigPlayerCollision(const sf::Vector3f& manifold, SceneNode* othe
 			mIsHitByBigPlayer = true;
 			mTimer = sf::Time::Zero;
 			move(mJump);
+			notifyChange();
 		}
 		else
 		{
 			destroy();
+			notifyChange();
 		}
 	}
 }
@@ -281,6 +323,7 @@ void Tile::brickSmallPlayerCollision(const sf::Vector3f& manifold, SceneNode* ot
 		mIsHitBySmallPlayer = true;
 		mTimer = sf::Time::Zero;
 		move(mJump);
+		notifyChange();
 	}
 }
 
@@ -293,6 +336,7 @@ void Tile::coinsBoxBigPlayerCollision(const sf::Vector3f& manifold, SceneNode* o
 		mTimer = sf::Time::Zero;
 		mIsFired = true;
 		move(mJump);
+		notifyChange();
 	}
 }
 
@@ -306,6 +350,7 @@ void Tile::coinsBoxSmallPlayerCollision(const sf::Vector3f& manifold, SceneNode*
 		mTimer = sf::Time::Zero;
 		mIsFired = true;
 		move(mJump);
+		notifyChange();
 	}
 }
 
@@ -317,6 +362,7 @@ void Tile::boxBigPlayerCollision(const sf::Vector3f& manifold, SceneNode* other)
 		mTimer = sf::Time::Zero;
 		mIsFired = true;
 		move(mJump);
+		notifyChange();
 	}
 }
 
@@ -329,6 +375,7 @@ void Tile::boxSmallPlayerCollision(const sf::Vector3f& manifold, SceneNode* othe
 		mTimer = sf::Time::Zero;
 		mIsFired = true;
 		move(mJump);
+		notifyChange();
 	}
 }
 
@@ -380,13 +427,15 @@ void Tile::updateAnimation(sf::Time dt)
 	mSprite.setTextureRect(textureRect);
 }
 
-void Tile::createItem(SceneNode& node, const TextureHolder& textures, Item::Type type)
+void Tile::createItem(SceneNode& node, Item::Type type)
 {
+	assert(mItems);
+
 	switch (type)
 	{
 	case Item::MoveableCoin:
 	{
-		auto item(std::make_unique<Item>(type, textures));
+		auto item(mItems->acquire(type));
 		item->setPosition(getWorldPosition());
 		item->setVelocity(0.f, -475.f);
 		node.attachChild(std::move(item));
@@ -394,7 +443,7 @@ void Tile::createItem(SceneNode& node, const TextureHolder& textures, Item::Type
 	break;
 	case Item::Mushroom:
 	{
-		auto item(std::make_unique<Item>(type, textures));
+		auto item(mItems->acquire(type));
 		item->setPosition(getWorldPosition());
 		item->setVelocity(0.f, -5.5f);
 		node.attachChild(std::move(item));
@@ -402,7 +451,7 @@ void Tile::createItem(SceneNode& node, const TextureHolder& textures, Item::Type
 	break;
 	case Item::Flower:
 	{
-		auto item(std::make_unique<Item>(type, textures));
+		auto item(mItems->acquire(type));
 		item->setPosition(getWorldPosition());
 		item->setVelocity(0.f, -5.5f);
 		node.attachChild(std::move(item));
@@ -410,7 +459,7 @@ void Tile::createItem(SceneNode& node, const TextureHolder& textures, Item::Type
 	break;
 	case Item::Star:
 	{
-		auto item(std::make_unique<Item>(type, textures));
+		auto item(mItems->acquire(type));
 		item->setPosition(getWorldPosition());
 		item->setVelocity(0.f, -5.5f);
 		node.attachChild(std::move(item));
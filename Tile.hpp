@@ -4,8 +4,10 @@
 #include "ResourceIdentifiers.hpp"
 #include "Command.hpp"
 #include "Item.hpp"
+#include "ObjectPool.hpp"
+#include "AtlasSprite.hpp"
+#include "CollisionTable.hpp"
 
-#include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 
 
@@ -27,27 +29,42 @@ public:
 
 
 private:
-	using DispatchHolder = std::vector<std::pair<Type, Dispatcher>>;
-	using FunctionUpdater = std::function<void(sf::Time, CommandQueue&)>;
+	using UpdateHandler = void (Tile::*)(sf::Time, CommandQueue&);
+	// rows are tile types, a box that turns solid loses its handlers
+	using Collisions = CollisionTable<Tile, TypeCount>;
 
 
 public:
-	explicit Tile(Type type, const TextureHolder& textures, sf::Vector2f size = {});
+	using ChangeCallback = std::function<void()>;
+
+
+public:
+	explicit Tile(Type type, const TextureHolder& textures, EntityStore& store, sf::Vector2f size = {});
 
 	void setCoinsCount(unsigned int count);
+	unsigned int getCoinsCount() const;
+	// boxes report SolidBox once emptied
+	Type getType() const;
+	// boxes spawn their items from this pool
+	void setItemPool(ObjectPool<Item>& items);
+
+	// called whenever the tile is bumped or destroyed
+	void setChangeCallback(ChangeCallback callback);
+
+	// leaves without breaking apart, for tiles scrolled out of the level
+	void remove() override;
 
 
 private:
-	void drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const override;
+	void drawCurrentBatched(SpriteBatch& batch, const sf::Transform& transform) const override;
 	void updateCurrent(sf::Time dt, CommandQueue& commands) override;
 
-	sf::FloatRect getBoundingRect() const override;
 	bool isMarkedForRemoval() const override;
 	unsigned int getCategory() const override;
+	unsigned int getPossibleCategories() const override;
 
 	void resolve(const sf::Vector3f& manifold, SceneNode* other) override;
 
-	sf::FloatRect getFootSensorBoundingRect() const override;
 
 	void setFootSenseCount(unsigned int count) override;
 	unsigned int getFootSenseCount() const override;
@@ -55,8 +72,12 @@ private:
 	void checkExplosion(CommandQueue& commands);
 	void updateAnimation(sf::Time dt);
 	void setup(sf::Vector2f size);
+	void updateColliders();
+	void notifyChange();
+
+	static const Collisions& getCollisionTable();
 
-	void createItem(SceneNode& node, const TextureHolder& textures, Item::Type type);
+	void createItem(SceneNode& node, Item::Type type);
 
 	void brickUpdate(sf::Time dt, CommandQueue& commands);
 	void boxUpdate(sf::Time dt, CommandQueue& commands);
@@ -74,7 +95,7 @@ private:
 
 private:
 	Type mType;
-	sf::Sprite mSprite;
+	AtlasSprite mSprite;
 	sf::RectangleShape mFootShape;
 	unsigned int mFootSenseCount;
 	bool mIsMarkedForRemoval;
@@ -92,7 +113,8 @@ private:
 
 	Command mCommand;
 	bool mIsFired;
+	ObjectPool<Item>* mItems;
 
-	Dispatcher mCollisionDispatcher;
-	FunctionUpdater mUpdater;
+	UpdateHandler mUpdater;
+	ChangeCallback mChangeCallback;
 };
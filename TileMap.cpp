@@ -1,76 +1,217 @@
 #include "TileMap.hpp"
-#include "pugixml/pugixml.hpp"
+#include "MapData.hpp"
+#include "MappedFile.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
 #include <iostream>
+#include <cassert>
+#include <cstring>
+#include <cmath>
 
 
 TileMap::TileMap()
-	: mVertices()
+	: mChunks()
+	, mLayerCount(0u)
+	, mChunkWidth(0.f)
+	, mViewBounds()
 	, mTileset()
 	, mObjects()
+	, mNames()
 	, mMapSize()
 {
 }
 
-bool TileMap::loadFromFile(const std::string& filename)
+bool TileMap::loadFromFile(const std::string& filename, bool loadTexture)
 {
-	pugi::xml_document mapDoc;
+	static const std::string Precompiled = ".lvl";
 
-	if (!mapDoc.load_file(filename.c_str()))
+	mChunks.clear();
+	mObjects.clear();
+	mNames.clear();
+
+	if (filename.size() >= Precompiled.size() && filename.compare(filename.size() - Precompiled.size(), Precompiled.size(), Precompiled) == 0)
+		return loadFromBinary(filename, loadTexture);
+
+	MapData data;
+	if (!data.loadFromTmx(filename))
+		return false;
+
+	std::vector<MapFormat::String> strings;
+	std::uint32_t offset = 0u;
+	std::string characters;
+
+	for (const auto& string : data.strings)
+	{
+		strings.push_back({ offset, static_cast<std::uint32_t>(string.size()) });
+		offset += static_cast<std::uint32_t>(string.size());
+		characters += string;
+	}
+
+	return load(data.header, data.tiles.data(), data.objects.data(), strings.data(), characters.data(), loadTexture);
+}
+
+bool TileMap::loadFromBinary(const std::string& filename, bool loadTexture)
+{
+	MappedFile file;
+
+	if (!file.open(filename) || file.getSize() < sizeof(MapFormat::Header))
 	{
 		std::cerr << "Loading level \"" + filename + "\" failed.\n";
 		return false;
 	}
 
-	auto mapNode = mapDoc.child("map");
+	const auto* data = file.getData();
 
-	auto width = mapNode.attribute("width").as_uint();
-	auto height = mapNode.attribute("height").as_uint();
-	auto tileWidth = mapNode.attribute("tilewidth").as_uint();
-	auto tileHeight = mapNode.attribute("tileheight").as_uint();
+	MapFormat::Header header;
+	std::memcpy(&header, data, sizeof(header));
 
-	mMapSize.x = mapNode.attribute("width").as_float() * mapNode.attribute("tilewidth").as_float();
-	mMapSize.y = mapNode.attribute("height").as_float() * mapNode.attribute("tileheight").as_float();
+	auto corrupt = [&filename]()
+	{
+		std::cerr << "Level \"" + filename + "\" is corrupt or out of date, convert it again.\n";
+		return false;
+	};
 
-	mVertices.setPrimitiveType(sf::Quads);
-	mVertices.resize(width * height * 4);
+	if (header.magic != MapFormat::Magic || header.version != MapFormat::Version)
+		return corrupt();
 
-	auto tilesetNode = mapNode.child("tileset");
+	// 32 bit counts multiplied in 64 bits can't wrap, except the tile count of three factors
+	const auto cells = std::uint64_t(header.width) * header.height;
+	if (header.layerCount != 0u && cells > file.getSize() / header.layerCount)
+		return corrupt();
 
-	auto firstTileID = tilesetNode.attribute("firstgid").as_uint();
+	const auto tilesSize = cells * header.layerCount * sizeof(std::uint32_t);
+	const auto objectsSize = std::uint64_t(header.objectCount) * sizeof(MapFormat::Object);
+	const auto stringsSize = std::uint64_t(header.stringCount) * sizeof(MapFormat::String);
 
-	auto image = tilesetNode.child("image");
+	if (file.getSize() != sizeof(header) + tilesSize + objectsSize + stringsSize + header.stringBytes)
+		return corrupt();
 
-	std::string imagePath = image.attribute("source").as_string();
+	// every section is a multiple of 4 bytes, the mapping itself is page aligned
+	const auto* tiles = data + sizeof(header);
+	const auto* objects = reinterpret_cast<const MapFormat::Object*>(tiles + tilesSize);
+	const auto* strings = reinterpret_cast<const MapFormat::String*>(tiles + tilesSize + objectsSize);
+	const auto* characters = tiles + tilesSize + objectsSize + stringsSize;
 
-	auto x = imagePath.find_first_of("./");
-	auto split = imagePath.substr(++x, imagePath.size());
+	// the file is trusted no further than its sizes, every offset and id is checked before use
+	for (auto i = 0u; i < header.stringCount; ++i)
+	{
+		if (std::uint64_t(strings[i].offset) + strings[i].length > header.stringBytes)
+			return corrupt();
+	}
+
+	if (header.tileset >= header.stringCount)
+		return corrupt();
 
-	if (!mTileset.loadFromFile("Media" + split))
+	for (auto i = 0u; i < header.objectCount; ++i)
 	{
-		std::cerr << "can't laod texture: Media" + split + "\n";
+		if (objects[i].name >= header.stringCount || objects[i].type >= header.stringCount)
+			return corrupt();
+	}
+
+	return load(header,
+		reinterpret_cast<const std::uint32_t*>(tiles),
+		objects,
+		strings,
+		characters, loadTexture);
+}
+
+bool TileMap::load(const MapFormat::Header& header,
+	const std::uint32_t* tiles,
+	const MapFormat::Object* objects,
+	const MapFormat::String* strings,
+	const char* characters,
+	bool loadTexture)
+{
+	for (auto i = 0u; i < header.stringCount; ++i)
+		mNames.emplace_back(characters + strings[i].offset, strings[i].length);
+
+	if (header.tileset >= mNames.size() || header.tileWidth == 0u || header.tileHeight == 0u)
+	{
+		std::cerr << "Level has no tileset.\n";
+		return false;
+	}
+
+	const auto& tilesetPath = mNames[header.tileset];
+
+	sf::Image tileset;
+	if (!tileset.loadFromFile(tilesetPath))
+	{
+		std::cerr << "can't laod texture: " + tilesetPath + "\n";
 		return false;
 	}
 
-	mTileset.setSmooth(true);
+	// sf::Texture is a GL resource, creating one needs a display even if it stays empty
+	mTileset.reset();
+	if (loadTexture)
+	{
+		mTileset = std::make_unique<sf::Texture>();
+		if (!mTileset->loadFromImage(tileset))
+		{
+			std::cerr << "can't laod texture: " + tilesetPath + "\n";
+			return false;
+		}
+
+		mTileset->setSmooth(true);
+	}
+
+	const auto width = header.width;
+	const auto height = header.height;
+	const auto tileWidth = header.tileWidth;
+	const auto tileHeight = header.tileHeight;
+
+	mMapSize.x = static_cast<float>(width * tileWidth);
+	mMapSize.y = static_cast<float>(height * tileHeight);
+
+	const auto columns = std::max(tileset.getSize().x / tileWidth, 1u);
+
+	mLayerCount = header.layerCount;
+
+	const auto chunkCount = (width + ChunkColumns - 1u) / ChunkColumns;
+
+	mChunkWidth = static_cast<float>(ChunkColumns * tileWidth);
+	mChunks.assign(chunkCount * mLayerCount, sf::VertexArray(sf::Quads));
+
+	// size every chunk up front so the quads are written in place
+	std::vector<std::size_t> quads(mChunks.size(), 0u);
+
+	for (auto layer = 0u; layer < mLayerCount; ++layer)
+	{
+		const auto* gids = tiles + std::size_t(layer) * width * height;
+
+		for (auto j = 0u; j < height; ++j)
+			for (auto i = 0u; i < width; ++i)
+				if (gids[i + j * width] >= header.firstTileID)
+					quads[(i / ChunkColumns) * mLayerCount + layer]++;
+	}
+
+	for (auto c = 0u; c < mChunks.size(); ++c)
+	{
+		mChunks[c].resize(quads[c] * 4);
+		quads[c] = 0u;
+	}
 
-	for (auto layerNode = mapNode.child("layer"); layerNode; layerNode = layerNode.next_sibling("layer"))
+	for (auto layer = 0u; layer < mLayerCount; ++layer)
 	{
-		auto dataNode = layerNode.child("data");
-		auto tileNode = dataNode.child("tile");
+		const auto* gids = tiles + std::size_t(layer) * width * height;
 
 		for (auto j = 0u; j < height; ++j)
 		{
 			for (auto i = 0u; i < width; ++i)
 			{
-				auto tileGID = tileNode.attribute("gid").as_uint();
-				tileGID -= firstTileID;
+				auto tileGID = gids[i + j * width];
+
+				// empty cell, lets lower layers show through
+				if (tileGID < header.firstTileID)
+					continue;
+
+				tileGID -= header.firstTileID;
 
-				auto tu = tileGID % (mTileset.getSize().x / tileWidth);
-				auto tv = tileGID / (mTileset.getSize().x / tileWidth);
+				auto tu = tileGID % columns;
+				auto tv = tileGID / columns;
 
-				auto* quad = &mVertices[(i + j * width) * 4];
+				const auto index = (i / ChunkColumns) * mLayerCount + layer;
+				auto* quad = &mChunks[index][quads[index]++ * 4];
 
 				quad[0].position = { static_cast<float>(i		* tileWidth), static_cast<float>(j		 * tileHeight) };
 				quad[1].position = { static_cast<float>((i + 1)	* tileWidth), static_cast<float>(j		 * tileHeight) };
@@ -83,34 +224,18 @@ bool TileMap::loadFromFile(const std::string& filename)
 				quad[1].texCoords = { (tu + 1)	* tileWidth - Fraction, tv		 * tileHeight + Fraction };
 				quad[2].texCoords = { (tu + 1)	* tileWidth - Fraction, (tv + 1) * tileHeight - Fraction };
 				quad[3].texCoords = { tu		* tileWidth + Fraction, (tv + 1) * tileHeight - Fraction };
-
-				tileNode = tileNode.next_sibling("tile");
 			}
 		}
 	}
 
-	for (auto node = mapNode.child("objectgroup"); node; node = node.next_sibling("objectgroup"))
+	mObjects.reserve(header.objectCount);
+	for (auto i = 0u; i < header.objectCount; ++i)
 	{
-		for (auto objectNode = node.child("object"); objectNode; objectNode = objectNode.next_sibling("object"))
-		{
-			std::string name = objectNode.attribute("name").as_string();
-			std::string type = objectNode.attribute("type").as_string();
-
-			sf::Vector2f position;
-			position.x = objectNode.attribute("x").as_float();
-			position.y = objectNode.attribute("y").as_float();
-
-			sf::Vector2f size;
-			size.x = objectNode.attribute("width").as_float();
-			size.y = objectNode.attribute("height").as_float();
+		const auto& object = objects[i];
 
-			auto propertisNode = objectNode.child("properties");
-			auto propertyNode = propertisNode.child("property");
-			unsigned int count = propertyNode.attribute("value").as_uint();
-
-			mObjects.emplace_back(name, type, position, size, count);
-		}
+		mObjects.push_back({ object.name, object.type, { object.x, object.y }, { object.width, object.height }, object.count });
 	}
+
 	return true;
 }
 
@@ -124,14 +249,44 @@ std::vector<TileMap::Object>::const_iterator TileMap::end() const
 	return mObjects.end();
 }
 
+const std::string& TileMap::getName(unsigned int id) const
+{
+	assert(id < mNames.size());
+
+	return mNames[id];
+}
+
 sf::Vector2f TileMap::getMapSize() const
 {
 	return mMapSize;
 }
 
+void TileMap::setViewBounds(const sf::FloatRect& bounds)
+{
+	mViewBounds = bounds;
+}
+
 void TileMap::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
-	states.texture = &mTileset;
+	if (mChunks.empty() || !mTileset)
+		return;
+
+	states.texture = mTileset.get();
+
+	const auto chunkCount = static_cast<int>(mChunks.size() / mLayerCount);
 
-	target.draw(mVertices, states);
+	auto first = std::max(static_cast<int>(std::floor(mViewBounds.left / mChunkWidth)), 0);
+	auto last = std::min(static_cast<int>(std::floor((mViewBounds.left + mViewBounds.width) / mChunkWidth)), chunkCount - 1);
+
+	// layers of a chunk cover the same cells, so chunk order keeps them stacked correctly
+	for (auto c = first; c <= last; ++c)
+	{
+		for (auto l = 0u; l < mLayerCount; ++l)
+		{
+			const auto& chunk = mChunks[c * mLayerCount + l];
+
+			if (chunk.getVertexCount() > 0)
+				target.draw(chunk, states);
+		}
+	}
 }
\ No newline at end of file
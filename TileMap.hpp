@@ -1,10 +1,15 @@
 #pragma once
 
+#include "MapFormat.hpp"
+
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Rect.hpp>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -13,20 +18,8 @@ class TileMap final : public sf::Drawable, private sf::NonCopyable
 {
 	struct Object
 	{
-		explicit Object(const std::string& name,
-			const std::string& type,
-			const sf::Vector2f& position,
-			const sf::Vector2f& size,
-			unsigned int count)
-			: name(name)
-			, type(type)
-			, position(position)
-			, size(size)
-			, count(count)
-		{}
-
-		std::string name;
-		std::string type;
+		unsigned int name;				// id for getName()
+		unsigned int type;				// id for getName()
 		sf::Vector2f position;
 		sf::Vector2f size;
 		unsigned int count;
@@ -36,21 +29,45 @@ class TileMap final : public sf::Drawable, private sf::NonCopyable
 public:
 	TileMap();
 
-	bool loadFromFile(const std::string& filename);
+	// .lvl files are precompiled levels and are memory mapped, anything else is read as .tmx
+	// without texture the tileset is only read on the CPU, for headless runs
+	bool loadFromFile(const std::string& filename, bool loadTexture = true);
 	
 	std::vector<Object>::const_iterator begin() const;
 	std::vector<Object>::const_iterator end() const;
 
+	// interned object names and types
+	const std::string& getName(unsigned int id) const;
+
 	sf::Vector2f getMapSize() const;
 
+	// only chunks intersecting these bounds are drawn
+	void setViewBounds(const sf::FloatRect& bounds);
+
 
 private:
+	bool loadFromBinary(const std::string& filename, bool loadTexture);
+	bool load(const MapFormat::Header& header,
+		const std::uint32_t* tiles,
+		const MapFormat::Object* objects,
+		const MapFormat::String* strings,
+		const char* characters,
+		bool loadTexture);
+
 	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
 
 private:
-	sf::VertexArray mVertices;
-	sf::Texture mTileset;
+	// map columns per chunk
+	static const unsigned int ChunkColumns = 16u;
+
+	// chunk c of layer l is stored at c * mLayerCount + l
+	std::vector<sf::VertexArray> mChunks;
+	std::size_t mLayerCount;
+	float mChunkWidth;
+	sf::FloatRect mViewBounds;
+	std::unique_ptr<sf::Texture> mTileset; // null when loaded without texture
 	std::vector<Object> mObjects;
+	std::vector<std::string> mNames;
 	sf::Vector2f mMapSize;
 };
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include <cstdlib>
 #include <cassert>
 
+#include <SFML/Graphics/Rect.hpp>
+
 #ifndef M_PI
 #define M_PI 3.141592653589793238462643383f
 #endif 
@@ -98,4 +100,9 @@ namespace utility
 	{
 		return std::sqrt(lengthSquared(source));
 	}
+	//Returns a given rect moved by offset
+	inline sf::FloatRect translate(const sf::FloatRect& rect, const sf::Vector2f& offset)
+	{
+		return { rect.left + offset.x, rect.top + offset.y, rect.width, rect.height };
+	}
 }
@@ -2,12 +2,17 @@
 #include "ParticleNode.hpp"
 #include "Enemy.hpp"
 #include "DebugText.hpp"
+#include "Profiler.hpp"
+#include "Utility.hpp"
 
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Window/Keyboard.hpp>
 
 #include <SFML/Graphics/RectangleShape.hpp>
 #include <iostream>
+#include <algorithm>
+#include <limits>
+#include <cassert>
 
 //#define Debug
 namespace
@@ -34,23 +39,131 @@ namespace
 
 		return manifold;
 	}
+
+	// Slab test of from moving by step against target. On a hit time is the
+	// fraction of the step at first contact and alongX the axis it enters on.
+	bool getTimeOfImpact(const sf::FloatRect& from, sf::Vector2f step, const sf::FloatRect& target, float& time, bool& alongX)
+	{
+		const auto infinity = std::numeric_limits<float>::infinity();
+
+		auto getSlab = [infinity](float min, float size, float delta, float targetMin, float targetSize, float& enter, float& exit)
+		{
+			if (delta > 0.f)
+			{
+				enter = (targetMin - (min + size)) / delta;
+				exit = (targetMin + targetSize - min) / delta;
+			}
+			else if (delta < 0.f)
+			{
+				enter = (targetMin + targetSize - min) / delta;
+				exit = (targetMin - (min + size)) / delta;
+			}
+			else
+			{
+				// still on this axis, the slabs overlap for the whole step or never
+				const auto overlap = min < targetMin + targetSize && targetMin < min + size;
+				enter = overlap ? -infinity : infinity;
+				exit = overlap ? infinity : -infinity;
+			}
+		};
+
+		float enterX, exitX, enterY, exitY;
+		getSlab(from.left, from.width, step.x, target.left, target.width, enterX, exitX);
+		getSlab(from.top, from.height, step.y, target.top, target.height, enterY, exitY);
+
+		const auto enter = std::max(enterX, enterY);
+		const auto exit = std::min(exitX, exitY);
+
+		if (enter >= exit || enter < 0.f || enter > 1.f)
+			return false;
+
+		time = enter;
+		alongX = enterX > enterY;
+		return true;
+	}
 }
 
 
-World::World(sf::RenderWindow& window)
-	: mWindow(window)
+World::World(sf::RenderWindow& window, const std::string& map)
+	: mWindow(&window)
 	, mWorldView(window.getDefaultView())
 	, mTileMap()
 	, mTextures()
+	, mSpriteBatch()
+	, mEntities()
+	, mEnemyPool(mTextures, mEntities)
+	, mItemPool(mTextures, mEntities)
+	, mProjectilePool(mTextures, mEntities)
+	, mCommandBus()
 	, mSceneGraph()
 	, mSceneLayers()
 	, mCommandQueue()
 	, mBodies()
+	, mBodyIndices()
+	, mSweptBodies()
+	, mBodyBounds()
+	, mBodySensors()
+	, mCandidates()
+	, mSweep()
+	, mStaticPairs()
+	, mTerrain()
+	, mTerrainProxy()
+	, mTerrainRects()
+	, mTerrainContacts()
+	, mStaticBodies()
+	, mStreamer()
 	, mPlayer()
 	, mPlayerController()
+	, mPhaseTimes()
+	, mParticleSystems()
+	, mParticlesInFlight(false)
+	, mWorkers()
+	, mUpdater(mWorkers)
+{
+	debug.setEnabled(true);
+	loadTextures();
+	buildScene(map);
+}
+
+World::World(sf::Vector2f viewSize, const std::string& map)
+	: mWindow(nullptr)
+	, mWorldView({ 0.f, 0.f, viewSize.x, viewSize.y })
+	, mTileMap()
+	, mTextures()
+	, mSpriteBatch()
+	, mEntities()
+	, mEnemyPool(mTextures, mEntities)
+	, mItemPool(mTextures, mEntities)
+	, mProjectilePool(mTextures, mEntities)
+	, mCommandBus()
+	, mSceneGraph()
+	, mSceneLayers()
+	, mCommandQueue()
+	, mBodies()
+	, mBodyIndices()
+	, mSweptBodies()
+	, mBodyBounds()
+	, mBodySensors()
+	, mCandidates()
+	, mSweep()
+	, mStaticPairs()
+	, mTerrain()
+	, mTerrainProxy()
+	, mTerrainRects()
+	, mTerrainContacts()
+	, mStaticBodies()
+	, mStreamer()
+	, mPlayer()
+	, mPlayerController(false)
+	, mPhaseTimes()
+	, mParticleSystems()
+	, mParticlesInFlight(false)
+	, mWorkers()
+	, mUpdater(mWorkers)
 {
+	debug.setEnabled(false);
 	loadTextures();
-	buildScene();
+	buildScene(map);
 }
 
 void World::handleEvent(const sf::Event& event)
@@ -60,7 +173,7 @@ void World::handleEvent(const sf::Event& event)
 	{
 	case sf::Event::MouseButtonPressed:
 		{
-			auto position = mWindow.mapPixelToCoords(sf::Mouse::getPosition(mWindow));
+			auto position = mWindow->mapPixelToCoords(sf::Mouse::getPosition(*mWindow));
 			switch (event.mouseButton.button)
 			{
 			case sf::Mouse::Left:
@@ -118,48 +231,109 @@ void World::handleEvent(const sf::Event& event)
 	}
 }
 
+void World::handleAction(PlayerController::Action action, bool pressed)
+{
+	mPlayerController.handleAction(action, pressed, mCommandQueue);
+}
+
 void World::update(sf::Time dt)
 {
+	PROFILE_SCOPE("World::update");
+
 	mPlayer.erase( // no more sorrow
 		std::remove_if(mPlayer.begin(), mPlayer.end(), 
 			std::mem_fn(&Player::isDestroyed)), 
 		mPlayer.end());
 
+	// particles simulated at the end of the last update must be done before emitting more
+	{
+		PROFILE_SCOPE("Particle wait");
+		mWorkers.wait();
+	}
+	if (mParticlesInFlight)
+	{
+		for (auto* system : mParticleSystems)
+			system->swapBuffers();
+
+		mParticlesInFlight = false;
+	}
+
 	mPlayerController.handleRealtimeInput(mCommandQueue);
 
 	destroyEntitiesOutsideView();
 
-	checkForCollision();
+	mPhaseTimes.fill(sf::Time::Zero);
+
+	{
+		PROFILE_PHASE("Command dispatch", mPhaseTimes[CommandDispatch]);
+		while (!mCommandQueue.isEmpty())
+		{
+			mCommandBus.dispatch(mCommandQueue.front());
+			mCommandQueue.pop();
+		}
+	}
+
+	{
+		PROFILE_PHASE("Level streaming", mPhaseTimes[LevelStreaming]);
+		mStreamer.update(getViewBounds());
+	}
+
+	{
+		PROFILE_PHASE("Wreck removal", mPhaseTimes[WreckRemoval]);
+		mSceneGraph.removeWrecks();
+	}
 
-	while (!mCommandQueue.isEmpty())
-		mSceneGraph.onCommand(mCommandQueue.pop());
+	{
+		PROFILE_PHASE("Collision gather", mPhaseTimes[CollisionGather]);
+		checkForCollision();
+	}
 
-	mSceneGraph.removeWrecks();
+	{
+		PROFILE_PHASE("Collision resolve", mPhaseTimes[CollisionResolve]);
+		handleCollision();
+	}
 
-	handleCollision();
+	// the last steps are swept by now, crushed or dying entities won't write a new one
+	mEntities.clearSteps();
 
 	if (!mPlayer.empty())
 	{
 		if (mPlayer.back()->paused())
 		{
 			mPlayer.back()->update(dt, mCommandQueue);
+			mEntities.integrate();
 			return;
 		}
 	}
 
 	updateCamera();
 
-	mSceneGraph.update(dt, mCommandQueue);
+	{
+		PROFILE_PHASE("Scene update", mPhaseTimes[SceneUpdate]);
+		mUpdater.update(mSceneGraph, dt, mCommandQueue);
+		mEntities.integrate();
+	}
 
 	debug.setPosition(mWorldView.getCenter() - sf::Vector2f(190.f, 100.f));
+
+	// runs on the workers while this frame is drawn from the front buffers
+	mParticlesInFlight = true;
+	mWorkers.dispatch(mParticleSystems.size(), [this, dt](std::size_t i) { mParticleSystems[i]->simulate(dt); });
 }
 
 void World::draw()
 {
-	mWindow.setView(mWorldView);
-	debug.draw(mWindow);
-	mWindow.draw(mTileMap);
-	mWindow.draw(mSceneGraph);
+	PROFILE_SCOPE("World::draw");
+
+	assert(mWindow);
+
+	mWindow->setView(mWorldView);
+	debug.draw(*mWindow);
+	mTileMap.setViewBounds(getViewBounds());
+	mWindow->draw(mTileMap);
+	mSpriteBatch.begin(*mWindow);
+	mSceneGraph.drawBatched(mSpriteBatch, sf::Transform::Identity);
+	mSpriteBatch.end();
 
 #ifdef Debug
 	sf::FloatRect viewBounds(mView.getCenter() - mView.getSize() / 2.f, mView.getSize());
@@ -168,21 +342,34 @@ void World::draw()
 	debugShape.setFillColor(sf::Color::Transparent);
 	debugShape.setOutlineColor(sf::Color::Cyan);
 	debugShape.setOutlineThickness(-3.f);
-	mWindow.draw(debugShape);
+	mWindow->draw(debugShape);
 #endif // Debug
 }
 
 void World::loadTextures()
 {
+	if (!mWindow)
+	{
+		// sprites only need their texture rects to simulate
+		for (auto id : { Textures::Player, Textures::Tile, Textures::Particle, Textures::Items, Textures::Enemies })
+			mTextures.insert(id, sf::Image());
+
+		mTextures.build(false);
+		return;
+	}
+
 	mTextures.load(Textures::Player, "Media/Textures/NES - Super Mario Bros - Mario Luigi.png");
 	mTextures.load(Textures::Tile, "Media/Textures/NES - Super Mario Bros - Tileset.png");
 	mTextures.load(Textures::Particle, "Media/Textures/Particle.png");
 	mTextures.load(Textures::Items, "Media/Textures/NES - Super Mario Bros - Items Objects.png");
 	mTextures.load(Textures::Enemies, "Media/Textures/NES - Super Mario Bros - Enemies.png");
+	mTextures.build();
 }
 
-void World::buildScene()
+void World::buildScene(const std::string& map)
 {
+	mSceneGraph.setCommandBus(mCommandBus);
+
 	for (auto i = 0u; i < LayerCount; ++i)
 	{
 		auto category = (i == Front) ? Category::FrontLayer : Category::BackLayer;
@@ -193,139 +380,212 @@ void World::buildScene()
 		mSceneGraph.attachChild(std::move(layer));
 	}
 
-	if (!mTileMap.loadFromFile("Media/Maps/test006.tmx"))
+	if (!mTileMap.loadFromFile(map, mWindow != nullptr))
 		throw std::runtime_error("can't load level");
 
 	mWorldBounds.left = mWorldBounds.top = 0.f;
 	mWorldBounds.width = mTileMap.getMapSize().x;
 	mWorldBounds.height = mTileMap.getMapSize().y;
 
+	mTerrain.reset(mWorldBounds);
+	mStaticBodies.reset(mWorldBounds, mTerrain);
+
+	mStreamer.reset(
+		[this](const LevelStreamer::Descriptor& descriptor) -> Entity& { return spawn(descriptor); },
+		[this](Entity& entity, LevelStreamer::Descriptor& descriptor) { despawn(entity, descriptor); });
+
 	mWorldView.zoom(0.5f);
 	mWorldView.setCenter(mWorldView.getSize() / 2.f);
 
 	for (const auto& object : mTileMap)
 	{
-		if (object.name == "player")
+		const auto& name = mTileMap.getName(object.name);
+		const auto& type = mTileMap.getName(object.type);
+
+		if (name == "player")
 		{
 			sf::Vector2f position = { object.position.x + object.size.x / 2.f, object.position.y + object.size.y / 2.f };
 			addPlayer(position);
 		}
 
-		if (object.name == "block")
+		// blocks are plain terrain, they only fill the collision layer
+		if (name == "block")
+			mTerrain.fill({ object.position, object.size });
+
+		// everything else waits in the streamer until the view gets near
+		if (name == "brick")
 		{
 			sf::Vector2f position = { object.position.x + object.size.x / 2.f, object.position.y + object.size.y / 2.f };
-			addBlock(position, object.size);
+			mStreamer.add({ SpawnBrick, 0u, position, 0u });
 		}
 
-		if (object.name == "brick")
+		if (name == "box")
 		{
 			sf::Vector2f position = { object.position.x + object.size.x / 2.f, object.position.y + object.size.y / 2.f };
-			addBrick(position);
-		}
 
-		if (object.name == "box")
-		{
-			if (object.type == "coin")
-			{
-				sf::Vector2f position = { object.position.x + object.size.x / 2.f, object.position.y + object.size.y / 2.f };
-				addBox(position, Tile::SoloCoinBox);
-			}
+			if (type == "coin")
+				mStreamer.add({ SpawnBox, Tile::SoloCoinBox, position, 0u });
 
-			if (object.type == "coins")
-			{
-				sf::Vector2f position = { object.position.x + object.size.x / 2.f, object.position.y + object.size.y / 2.f };
-				addBox(position, Tile::CoinsBox, object.count);
-			}
+			if (type == "coins")
+				mStreamer.add({ SpawnBox, Tile::CoinsBox, position, object.count });
 
-			if (object.type == "transform")
-			{
-				sf::Vector2f position = { object.position.x + object.size.x / 2.f, object.position.y + object.size.y / 2.f };
-				addBox(position, Tile::TransformBox);
-			}
+			if (type == "transform")
+				mStreamer.add({ SpawnBox, Tile::TransformBox, position, 0u });
 
-			if (object.type == "fire")
-			{
-				sf::Vector2f position = { object.position.x + object.size.x / 2.f, object.position.y + object.size.y / 2.f };
-				addBox(position, Tile::FireBox);
-			}
+			if (type == "fire")
+				mStreamer.add({ SpawnBox, Tile::FireBox, position, 0u });
 
-			if (object.type == "shift")
-			{
-				sf::Vector2f position = { object.position.x + object.size.x / 2.f, object.position.y + object.size.y / 2.f };
-				addBox(position, Tile::ShiftBox);
-			}
+			if (type == "shift")
+				mStreamer.add({ SpawnBox, Tile::ShiftBox, position, 0u });
 		}
 
-		if (object.name == "goomba")
+		if (name == "goomba")
 		{
 			sf::Vector2f position = { object.position.x + object.size.x / 2.f, object.position.y + object.size.y };
-			addGoomba(position);
+			mStreamer.add({ SpawnGoomba, 0u, position, 0u });
 		}
 
-		if (object.name == "static_coin")
+		if (name == "static_coin")
 		{
 			sf::Vector2f position = { object.position.x + object.size.x / 2.f, object.position.y + object.size.y / 2.f };
-			addItem(Item::StaticCoin, position);
+			mStreamer.add({ SpawnCoin, 0u, position, 0u });
 		}
 	}
 
 	createParticle();
+
+	mStreamer.update(getViewBounds());
+}
+
+Entity& World::spawn(const LevelStreamer::Descriptor& descriptor)
+{
+	switch (descriptor.kind)
+	{
+	case SpawnBrick:
+		return addBrick(descriptor.position);
+	case SpawnBox:
+		return addBox(descriptor.position, static_cast<Tile::Type>(descriptor.type), descriptor.count);
+	case SpawnGoomba:
+		return addGoomba(descriptor.position);
+	default:
+		assert(descriptor.kind == SpawnCoin);
+		return addItem(Item::StaticCoin, descriptor.position);
+	}
+}
+
+void World::despawn(Entity& entity, LevelStreamer::Descriptor& descriptor)
+{
+	switch (descriptor.kind)
+	{
+	case SpawnBox:
+		{
+			// an emptied box comes back solid
+			const auto& box = static_cast<const Tile&>(entity);
+			descriptor.type = box.getType();
+			descriptor.count = box.getCoinsCount();
+		}
+		break;
+	case SpawnGoomba:
+		descriptor.position = entity.getPosition();
+		break;
+	default: break;
+	}
+
+	entity.remove();
 }
 
 void World::addPlayer(sf::Vector2f position)
 {
 	if (mPlayer.empty())
 	{
-		auto player(std::make_unique<Player>(Player::SmallPlayer, mTextures));
+		auto player(std::make_unique<Player>(Player::SmallPlayer, mTextures, mEntities, mProjectilePool));
 		mPlayer.emplace_back(player.get());
 		mPlayer.back()->setPosition(position);
 		mSceneLayers[Front]->attachChild(std::move(player));
 	}
 }
 
-void World::addGoomba(sf::Vector2f position)
+Enemy& World::addGoomba(sf::Vector2f position)
 {
-	auto goomba(std::make_unique<Enemy>(Enemy::Goomba, mTextures));
+	auto goomba(mEnemyPool.acquire(Enemy::Goomba));
 	goomba->setPosition(position);
 	goomba->setVelocity(-40.f, 0.f);
+	auto& enemy = *goomba;
 	mSceneLayers[Front]->attachChild(std::move(goomba));
+	return enemy;
 }
 
 void World::addTroopa(sf::Vector2f position)
 {
-	auto troopa(std::make_unique<Enemy>(Enemy::Troopa, mTextures));
+	auto troopa(mEnemyPool.acquire(Enemy::Troopa));
 	troopa->setPosition(position);
 	troopa->setVelocity(-40.f, 0.f);
 	mSceneLayers[Front]->attachChild(std::move(troopa));
 }
 
-void World::addBrick(sf::Vector2f position)
+Tile& World::addBrick(sf::Vector2f position)
 {
-	auto brick(std::make_unique<Tile>(Tile::Brick, mTextures));
+	auto brick(std::make_unique<Tile>(Tile::Brick, mTextures, mEntities));
 	brick->setPosition(position);
+	auto& body = *brick;
 	mSceneLayers[Back]->attachChild(std::move(brick));
+	addStaticBody(body);
+	return body;
 }
 
-void World::addBlock(sf::Vector2f position, sf::Vector2f size)
+Tile& World::addBox(sf::Vector2f position, Tile::Type type, unsigned int count)
 {
-	auto block(std::make_unique<Tile>(Tile::Block, mTextures, size));
-	block->setPosition(position);
-	mSceneLayers[Back]->attachChild(std::move(block));
-}
-
-void World::addBox(sf::Vector2f position, Tile::Type type, unsigned int count)
-{
-	auto box(std::make_unique<Tile>(type, mTextures));
+	auto box(std::make_unique<Tile>(type, mTextures, mEntities));
 	box->setPosition(position);
 	box->setCoinsCount(count);
+	box->setItemPool(mItemPool);
+	auto& body = *box;
 	mSceneLayers[Front]->attachChild(std::move(box));
+	addStaticBody(body);
+	return body;
+}
+
+void World::addStaticBody(Tile& tile)
+{
+	auto id = mStaticBodies.insert(tile);
+	tile.setChangeCallback([this, id]
+	{
+		mStaticBodies.update(id);
+	});
 }
 
-void World::addItem(Item::Type type, sf::Vector2f position)
+Item& World::addItem(Item::Type type, sf::Vector2f position)
 {
-	auto item(std::make_unique<Item>(type, mTextures));
+	auto item(mItemPool.acquire(type));
 	item->setPosition(position);
+	auto& body = *item;
 	mSceneLayers[Back]->attachChild(std::move(item));
+	return body;
+}
+
+sf::FloatRect World::getWorldBounds() const
+{
+	return mWorldBounds;
+}
+
+std::size_t World::getBodyCount() const
+{
+	return mBodies.size() + mStaticBodies.getBodyCount();
+}
+
+const World::PhaseTimes& World::getPhaseTimes() const
+{
+	return mPhaseTimes;
+}
+
+const CommandQueue& World::getCommandQueue() const
+{
+	return mCommandQueue;
+}
+
+std::size_t World::getPoolAllocationCount() const
+{
+	return mEnemyPool.getAllocationCount() + mItemPool.getAllocationCount() + mProjectilePool.getAllocationCount();
 }
 
 sf::FloatRect World::getViewBounds() const
@@ -349,52 +609,190 @@ void World::destroyEntitiesOutsideView()
 void World::checkForCollision()
 {
 	mBodies.clear();
+	mBodyIndices.clear();
 
-	Command command;
-	command.category = Category::All;
-	command.action = [this](auto& node)
+	// level tiles live in mStaticBodies, only moving bodies are gathered,
+	// runs after removeWrecks so every gathered body is alive this tick
+	const auto& owners = mEntities.getOwners();
+	const auto& hitpoints = mEntities.getHitpoints();
+
+	const auto& steps = mEntities.getSteps();
+
+	mSweptBodies.clear();
+
+	for (auto i = std::size_t(0u); i < owners.size(); ++i)
 	{
-		if (!node.isDestroyed())
-			mBodies.emplace_back(&node);
-	};
+		if (hitpoints[i] > 0 && (owners[i]->getCategory() & Category::Dynamic))
+		{
+			if (owners[i]->isContinuousCollision() && steps[i] != sf::Vector2f())
+				mSweptBodies.emplace_back(mBodies.size(), steps[i]);
 
-	mCommandQueue.push(command);
+			mBodies.emplace_back(owners[i]);
+			mBodyIndices.emplace_back(i);
+		}
+	}
 }
 
-void World::handleCollision()
+void World::sweepFastBodies()
 {
-	std::set<SceneNode::Pair> collisions;
+	// how far a swept body is left inside what it hit, enough for the discrete pass to pick it up
+	const auto Penetration = 0.01f;
 
-	for (const auto& bodyA : mBodies)
+	const auto& staticBounds = mStaticBodies.getBoundingRects();
+
+	auto& positions = mEntities.getPositions();
+	const auto& colliders = mEntities.getColliders();
+
+	for (const auto& swept : mSweptBodies)
 	{
-		bodyA->setFootSenseCount(0u);
-		for (const auto& bodyB : mBodies)
+		const auto index = mBodyIndices[swept.first];
+		const auto step = swept.second;
+
+		const auto bounds = utility::translate(colliders[index], positions[index]);
+		const sf::FloatRect from(bounds.left - step.x, bounds.top - step.y, bounds.width, bounds.height);
+
+		const auto left = std::min(from.left, bounds.left);
+		const auto top = std::min(from.top, bounds.top);
+		const sf::FloatRect area(left, top,
+			std::max(from.left, bounds.left) + bounds.width - left,
+			std::max(from.top, bounds.top) + bounds.height - top);
+
+		auto earliest = 1.f;
+		auto alongX = false;
+		auto hit = false;
+
+		auto test = [&](const sf::FloatRect& target)
 		{
-			if (bodyA == bodyB) continue;
+			// anything overlapped at either end is found by the discrete pass
+			if (target.intersects(bounds) || target.intersects(from)) return;
 
-			//primary collision between bounding boxes
-			if (bodyA->getBoundingRect().intersects(bodyB->getBoundingRect()))
+			float time;
+			bool axis;
+			if (getTimeOfImpact(from, step, target, time, axis) && time < earliest)
 			{
-				collisions.insert(std::minmax(bodyA, bodyB));
+				earliest = time;
+				alongX = axis;
+				hit = true;
 			}
+		};
 
-			//secondary collisions with sensor boxes
-			if (bodyA->getFootSensorBoundingRect().intersects(bodyB->getBoundingRect()))
-			{
-				auto count = bodyA->getFootSenseCount();
+		mStaticBodies.queryBodies(area, mCandidates);
+		for (auto j : mCandidates)
+			test(staticBounds.get(j));
+
+		mTerrain.query(area, mTerrainRects);
+		for (const auto& rect : mTerrainRects)
+			test(rect);
+
+		if (!hit) continue;
+
+		// tunnelled, back to the first contact and resolved like any other overlap
+		auto offset = step * (earliest - 1.f);
+		if (alongX)
+			offset.x += (step.x > 0.f) ? Penetration : -Penetration;
+		else
+			offset.y += (step.y > 0.f) ? Penetration : -Penetration;
+
+		positions[index] += offset;
+	}
+}
+
+void World::handleCollision()
+{
+	sweepFastBodies();
+
+	// snapshot bounds and sensors once per tick, the pair tests below only read these arrays
+	const auto& positions = mEntities.getPositions();
+	const auto& colliders = mEntities.getColliders();
+	const auto& sensors = mEntities.getSensors();
+
+	mBodyBounds.clear();
+	mBodySensors.clear();
+	for (auto index : mBodyIndices)
+	{
+		mBodyBounds.push(utility::translate(colliders[index], positions[index]));
+		mBodySensors.push(utility::translate(sensors[index], positions[index]));
+	}
+
+	// moving against moving bodies, pairs and sensor counts
+	mSweep.update(mBodies, mBodyBounds, mBodySensors);
+
+	const auto& staticBounds = mStaticBodies.getBoundingRects();
+	const auto& staticSensors = mStaticBodies.getFootSensorBoundingRects();
+
+	mStaticBodies.clearContacts();
+	mStaticPairs.clear();
+	mTerrainContacts.clear();
+
+	// static against static pairs are skipped, tiles never resolve against tiles
+	for (auto i = 0u; i < mBodies.size(); ++i)
+	{
+		auto* bodyA = mBodies[i];
+		const auto bounds = mBodyBounds.get(i);
+
+		//primary collision between bounding boxes
+		mStaticBodies.queryBodies(bounds, mCandidates);
+		for (auto j : mCandidates)
+		{
+			if (mBodyBounds.intersects(i, staticBounds, j))
+				mStaticPairs.emplace_back(bodyA, mStaticBodies.get(j));
+		}
+
+		//terrain cells around the bounds, looked up directly in the collision layer
+		mTerrain.query(bounds, mTerrainRects);
+		for (const auto& rect : mTerrainRects)
+			mTerrainContacts.emplace_back(bodyA, rect);
+
+		//secondary collisions with sensor boxes
+		const auto sensor = mBodySensors.get(i);
+		auto count = mSweep.getSensorCount(i);
+
+		mStaticBodies.queryBodies(sensor, mCandidates);
+		for (auto j : mCandidates)
+		{
+			if (mBodySensors.intersects(i, staticBounds, j))
 				count++;
-				bodyA->setFootSenseCount(count);
-			}
+		}
+
+		if (mTerrain.intersects(sensor))
+			count++;
+
+		bodyA->setFootSenseCount(count);
+
+		//static sensors touched by this body
+		mStaticBodies.querySensors(bounds, mCandidates);
+		for (auto j : mCandidates)
+		{
+			if (staticSensors.intersects(j, mBodyBounds, i))
+				mStaticBodies.addContact(j);
 		}
 	}
 
-	//resolve collision for each pair
-	for (const auto& pair : collisions)
+	mStaticBodies.applyFootSenseCounts();
+
+	auto resolve = [](const SceneNode::Pair& pair)
 	{
 		auto man = getManifold(pair);
 		pair.second->resolve(man, pair.first);
 		man.z = -man.z;
 		pair.first->resolve(man, pair.second);
+	};
+
+	//resolve collision for each pair, ended contacts are gone or apart
+	for (const auto& contact : mSweep.getContacts())
+	{
+		if (contact.event != SweepAndPrune::End)
+			resolve({ contact.first, contact.second });
+	}
+
+	for (const auto& pair : mStaticPairs)
+		resolve(pair);
+
+	// one proxy stands in for every terrain rect, it is only read during resolve
+	for (const auto& contact : mTerrainContacts)
+	{
+		mTerrainProxy.setBounds(contact.second);
+		resolve({ contact.first, &mTerrainProxy });
 	}
 }
 
@@ -415,5 +813,7 @@ void World::createParticle()
 	explosion->addAffector(ForceAffector({ 0.f, 160.f }));//gravity
 	explosion->addAffector(RotateAffector(360.f));
 
+	mParticleSystems.push_back(explosion.get());
+
 	mSceneLayers[Back]->attachChild(std::move(explosion));
 }
\ No newline at end of file
@@ -1,14 +1,26 @@
 #pragma once
 
-#include "ResourceHolder.hpp"
+#include "TextureAtlas.hpp"
 #include "ResourceIdentifiers.hpp"
 #include "TileMap.hpp"
 #include "SceneNode.hpp"
 #include "Player.hpp"
 #include "CommandQueue.hpp"
+#include "CommandBus.hpp"
 #include "PlayerController.hpp"
 #include "Tile.hpp"
 #include "Item.hpp"
+#include "Enemy.hpp"
+#include "Projectile.hpp"
+#include "ObjectPool.hpp"
+#include "SweepAndPrune.hpp"
+#include "RectArray.hpp"
+#include "StaticBodyIndex.hpp"
+#include "TerrainGrid.hpp"
+#include "LevelStreamer.hpp"
+#include "ThreadPool.hpp"
+#include "ParallelUpdater.hpp"
+#include "SpriteBatch.hpp"
 
 #include <SFML/Graphics/View.hpp>
 
@@ -20,6 +32,8 @@ namespace sf
 	class RenderWindow;
 }
 
+class ParticleNode;
+
 class World : sf::NonCopyable
 {
 
@@ -32,47 +46,113 @@ class World : sf::NonCopyable
 
 	using LayerContainer = std::array<SceneNode*, LayerCount>;
 
+	// descriptor kinds of the level streamer
+	enum Spawn
+	{
+		SpawnBrick,
+		SpawnBox,
+		SpawnGoomba,
+		SpawnCoin
+	};
+
 
 public:
-	explicit World(sf::RenderWindow& window);
+	// hot path phases of update(), timed every tick
+	enum Phase
+	{
+		CollisionGather,
+		CommandDispatch,
+		WreckRemoval,
+		CollisionResolve,
+		SceneUpdate,
+		LevelStreaming,
+		PhaseCount
+	};
+
+	using PhaseTimes = std::array<sf::Time, PhaseCount>;
+
+
+public:
+	explicit World(sf::RenderWindow& window, const std::string& map = "Media/Maps/test006.tmx");
+	// headless, no window and no GPU resources; draw() must not be called
+	explicit World(sf::Vector2f viewSize, const std::string& map);
 
 	void handleEvent(const sf::Event& event);
+	void handleAction(PlayerController::Action action, bool pressed);
 	void update(sf::Time dt);
 	void draw();
 
+	Enemy& addGoomba(sf::Vector2f position);
+	void addTroopa(sf::Vector2f position);
+
+	sf::FloatRect getWorldBounds() const;
+	std::size_t getBodyCount() const;
+	const PhaseTimes& getPhaseTimes() const;
+	const CommandQueue& getCommandQueue() const;
+	// enemies, items and projectiles ever constructed, recycled spawns don't count
+	std::size_t getPoolAllocationCount() const;
+
 
 private:
 	void loadTextures();
-	void buildScene();
+	void buildScene(const std::string& map);
 
 	void destroyEntitiesOutsideView();
 	sf::FloatRect getViewBounds() const;
 
 	void checkForCollision();
+	void sweepFastBodies();
 	void handleCollision();
 
 	void updateCamera();
 	void createParticle();
 
 	void addPlayer(sf::Vector2f position);
-	void addGoomba(sf::Vector2f position);
-	void addTroopa(sf::Vector2f position);
-	void addBrick(sf::Vector2f position);
-	void addBox(sf::Vector2f position, Tile::Type type, unsigned int count = 0);
-	void addBlock(sf::Vector2f position, sf::Vector2f size);
-	void addItem(Item::Type type, sf::Vector2f position);
+	Tile& addBrick(sf::Vector2f position);
+	Tile& addBox(sf::Vector2f position, Tile::Type type, unsigned int count = 0);
+	Item& addItem(Item::Type type, sf::Vector2f position);
+	void addStaticBody(Tile& tile);
+
+	Entity& spawn(const LevelStreamer::Descriptor& descriptor);
+	void despawn(Entity& entity, LevelStreamer::Descriptor& descriptor);
 
 
 private:
-	sf::RenderWindow& mWindow;
+	sf::RenderWindow* mWindow;
 	sf::View mWorldView;
 	sf::FloatRect mWorldBounds;
 	TileMap mTileMap;
 	TextureHolder mTextures;
+	SpriteBatch mSpriteBatch;
+	// declared before every owner of entities, so it outlives them
+	EntityStore mEntities;
+	ObjectPool<Enemy> mEnemyPool;
+	ObjectPool<Item> mItemPool;
+	ObjectPool<Projectile> mProjectilePool;
+	CommandBus mCommandBus;
 	SceneNode mSceneGraph;
 	LayerContainer mSceneLayers;
 	CommandQueue mCommandQueue;
 	std::vector<SceneNode*> mBodies;
+	std::vector<std::size_t> mBodyIndices; // index in mEntities, stable until the next removal
+	std::vector<std::pair<std::size_t, sf::Vector2f>> mSweptBodies; // index in mBodies, last step
+	RectArray mBodyBounds;
+	RectArray mBodySensors;
+	std::vector<std::size_t> mCandidates;
+	SweepAndPrune mSweep;
+	std::vector<SceneNode::Pair> mStaticPairs;
+	TerrainGrid mTerrain;
+	TerrainGrid::Proxy mTerrainProxy;
+	std::vector<sf::FloatRect> mTerrainRects;
+	std::vector<std::pair<SceneNode*, sf::FloatRect>> mTerrainContacts;
+	StaticBodyIndex mStaticBodies;
+	LevelStreamer mStreamer;
 	std::vector<Player*> mPlayer;
 	PlayerController mPlayerController;
+	PhaseTimes mPhaseTimes;
+	std::vector<ParticleNode*> mParticleSystems;
+	bool mParticlesInFlight;
+	// declared after the scene graph, so it finishes in flight particles before the graph goes away
+	ThreadPool mWorkers;
+	ParallelUpdater mUpdater;
 };